@@ -59,11 +59,17 @@ uint8_t ssd1306_basic_init(ssd1306_interface_t interface,
 	DRIVER_SSD1306_LINK_IIC_DEINIT(&gs_handle,
 				       ssd1306_interface_iic_deinit);
 	DRIVER_SSD1306_LINK_IIC_WRITE(&gs_handle, ssd1306_interface_iic_write);
+	DRIVER_SSD1306_LINK_IIC_WRITE_HEADROOM(&gs_handle,
+					       ssd1306_interface_iic_write_headroom);
 	DRIVER_SSD1306_LINK_SPI_INIT(&gs_handle, ssd1306_interface_spi_init);
 	DRIVER_SSD1306_LINK_SPI_DEINIT(&gs_handle,
 				       ssd1306_interface_spi_deinit);
 	DRIVER_SSD1306_LINK_SPI_WRITE_COMMAND(&gs_handle,
 					      ssd1306_interface_spi_write_cmd);
+	DRIVER_SSD1306_LINK_SPI_WRITE_BATCH(&gs_handle,
+					    ssd1306_interface_spi_write_batch);
+	DRIVER_SSD1306_LINK_BUS_SET_SPEED(&gs_handle,
+					  ssd1306_interface_bus_set_speed);
 	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_INIT(
 		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_init);
 	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_DEINIT(
@@ -79,6 +85,10 @@ uint8_t ssd1306_basic_init(ssd1306_interface_t interface,
 	DRIVER_SSD1306_LINK_DELAY_MS(&gs_handle, ssd1306_interface_delay_ms);
 	DRIVER_SSD1306_LINK_DEBUG_PRINT(&gs_handle,
 					ssd1306_interface_debug_print);
+#if ((SSD1306_STATS == 1) || (SSD1306_TRACE_SIZE > 0))
+	DRIVER_SSD1306_LINK_TIMESTAMP_US(&gs_handle,
+					 ssd1306_interface_timestamp_us);
+#endif
 
 	/* set interface */
 	res = ssd1306_set_interface(&gs_handle, interface);
@@ -105,6 +115,16 @@ uint8_t ssd1306_basic_init(ssd1306_interface_t interface,
 		return 1;
 	}
 
+	/* queue the configuration commands */
+	res = ssd1306_command_batch_begin(&gs_handle);
+	if (res != 0) {
+		ssd1306_interface_debug_print(
+			"ssd1306: command batch begin failed.\n");
+		(void)ssd1306_deinit(&gs_handle);
+
+		return 1;
+	}
+
 	/* close display */
 	res = ssd1306_set_display(&gs_handle, SSD1306_DISPLAY_OFF);
 	if (res != 0) {
@@ -356,6 +376,16 @@ uint8_t ssd1306_basic_init(ssd1306_interface_t interface,
 		return 1;
 	}
 
+	/* send the configuration commands */
+	res = ssd1306_command_batch_commit(&gs_handle);
+	if (res != 0) {
+		ssd1306_interface_debug_print(
+			"ssd1306: command batch commit failed.\n");
+		(void)ssd1306_deinit(&gs_handle);
+
+		return 1;
+	}
+
 	/* clear screen */
 	res = ssd1306_clear(&gs_handle);
 	if (res != 0) {
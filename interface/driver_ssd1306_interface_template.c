@@ -77,6 +77,21 @@ uint8_t ssd1306_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return 0;
 }
 
+/**
+ * @brief     interface iic bus write with headroom
+ * @param[in] addr is the iic device write address
+ * @param[in] *buf points to a data buffer starting with the control byte
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      optional, the buffer is sent as it is without any copy
+ */
+uint8_t ssd1306_interface_iic_write_headroom(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -115,6 +130,59 @@ uint8_t ssd1306_interface_spi_write_cmd(uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief     interface spi bus write batch
+ * @param[in] **buf points to the segment buffers
+ * @param[in] *len points to the segment lengths
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      optional, all segments are sent in one submission and cs is released between them
+ */
+uint8_t ssd1306_interface_spi_write_batch(uint8_t **buf, uint16_t *len, uint8_t num)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface bus set speed
+ * @param[in] interface is the interface in use
+ * @param[in] hz is the bus clock in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      optional, the probe steps through the clocks with it
+ */
+uint8_t ssd1306_interface_bus_set_speed(uint8_t interface, uint32_t hz)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface bus read back
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       optional, it returns the last bytes echoed by a loopback wiring of the data line
+ */
+uint8_t ssd1306_interface_bus_read_back(uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief  interface get the monotonic time
+ * @return time in us
+ * @note   it may wrap around
+ */
+uint32_t ssd1306_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms
@@ -208,3 +276,38 @@ uint8_t ssd1306_interface_reset_gpio_write(uint8_t value)
 {
     return 0;
 }
+
+/**
+ * @brief     interface async write
+ * @param[in] interface is the interface type
+ * @param[in] addr is the iic device write address
+ * @param[in] *cmd points to a command buffer
+ * @param[in] cmd_len is the command buffer length
+ * @param[in] *data points to a data buffer
+ * @param[in] data_len is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      optional, it starts the command transfer followed by the data transfer and returns at once,
+ *            both buffers stay valid until the transfer is reported finished
+ */
+uint8_t ssd1306_interface_async_write(uint8_t interface, uint8_t addr, uint8_t *cmd, uint16_t cmd_len,
+                                      uint8_t *data, uint16_t data_len)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface async poll
+ * @param[out] *busy points to a busy flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the finished transfer failed
+ * @note       optional
+ */
+uint8_t ssd1306_interface_async_poll(uint8_t *busy)
+{
+    *busy = 0;
+    
+    return 0;
+}
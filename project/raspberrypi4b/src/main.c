@@ -37,6 +37,8 @@
 #include "driver_ssd1306_basic.h"
 #include "driver_ssd1306_advance.h"
 #include "driver_ssd1306_display_test.h"
+#include "driver_ssd1306_flush_test.h"
+#include "driver_ssd1306_render_test.h"
 #include "shell.h"
 #include <getopt.h>
 #include <sys/types.h>
@@ -381,6 +383,20 @@ uint8_t ssd1306(uint8_t argc, char **argv)
 		} else {
 			return 0;
 		}
+	} else if (strcmp("t_flush", type) == 0) {
+		/* run flush test */
+		if (ssd1306_flush_test(interface, addr) != 0) {
+			return 1;
+		} else {
+			return 0;
+		}
+	} else if (strcmp("t_render", type) == 0) {
+		/* run render test */
+		if (ssd1306_render_test(interface, addr) != 0) {
+			return 1;
+		} else {
+			return 0;
+		}
 	} else if (strcmp("e_basic-str", type) == 0) {
 		uint8_t res;
 
@@ -840,6 +856,10 @@ help:
 		ssd1306_interface_debug_print("  ssd1306 (-p | --port)\n");
 		ssd1306_interface_debug_print(
 			"  ssd1306 (-t display | --test=display) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
+		ssd1306_interface_debug_print(
+			"  ssd1306 (-t flush | --test=flush) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
+		ssd1306_interface_debug_print(
+			"  ssd1306 (-t render | --test=render) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
 		ssd1306_interface_debug_print(
 			"  ssd1306 (-e basic-init | --example=basic-init) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
 		ssd1306_interface_debug_print(
@@ -934,7 +954,7 @@ help:
 		ssd1306_interface_debug_print(
 			"      --str=<string>      Set the display string.([default: libdriver])\n");
 		ssd1306_interface_debug_print(
-			"  -t <display>, --test=<display>\n");
+			"  -t <display | flush | render>, --test=<display | flush | render>\n");
 		ssd1306_interface_debug_print(
 			"                          Run the driver test.\n");
 		ssd1306_interface_debug_print(
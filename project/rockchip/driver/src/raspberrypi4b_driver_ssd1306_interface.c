@@ -39,7 +39,9 @@
 #include "iic.h"
 #include "spi.h"
 #include "wire.h"
+#include <pthread.h>
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -101,6 +103,21 @@ uint8_t ssd1306_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return iic_write(gs_iic_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus write with headroom
+ * @param[in] addr is the iic device write address
+ * @param[in] *buf points to a data buffer starting with the control byte
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffer goes to I2C_RDWR without any copy
+ */
+uint8_t ssd1306_interface_iic_write_headroom(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_write_cmd(gs_iic_fd, addr, buf, len);
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -139,6 +156,54 @@ uint8_t ssd1306_interface_spi_write_cmd(uint8_t *buf, uint16_t len)
     return spi_write_cmd(gs_spi_fd, buf, len);
 }
 
+/**
+ * @brief     interface spi bus write batch
+ * @param[in] **buf points to the segment buffers
+ * @param[in] *len points to the segment lengths
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      all segments go out in one SPI_IOC_MESSAGE ioctl
+ */
+uint8_t ssd1306_interface_spi_write_batch(uint8_t **buf, uint16_t *len, uint8_t num)
+{
+    return spi_write_cmd_batch(gs_spi_fd, buf, len, num);
+}
+
+/**
+ * @brief     interface bus set speed
+ * @param[in] interface is the interface in use
+ * @param[in] hz is the bus clock in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      optional, the iic clock is fixed by the kernel device tree
+ */
+uint8_t ssd1306_interface_bus_set_speed(uint8_t interface, uint32_t hz)
+{
+    if (interface == SSD1306_INTERFACE_IIC)
+    {
+        return 1;
+    }
+    
+    return spi_set_speed(gs_spi_fd, hz);
+}
+
+/**
+ * @brief  interface get the monotonic time
+ * @return time in us
+ * @note   it may wrap around
+ */
+uint32_t ssd1306_interface_timestamp_us(void)
+{
+    struct timespec t;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint32_t)((uint64_t)t.tv_sec * 1000000 + t.tv_nsec / 1000);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms
@@ -242,3 +307,170 @@ uint8_t ssd1306_interface_reset_gpio_write(uint8_t value)
 {
     return wire_clock_write(value);
 }
+
+/**
+ * @brief async transfer definition
+ */
+static pthread_t gs_async_thread;                                        /**< async worker thread */
+static pthread_mutex_t gs_async_mutex = PTHREAD_MUTEX_INITIALIZER;       /**< async request mutex */
+static pthread_cond_t gs_async_cond = PTHREAD_COND_INITIALIZER;          /**< async request condition */
+static uint8_t gs_async_started;                                         /**< async worker started flag */
+static uint8_t gs_async_request;                                         /**< async request flag */
+static uint8_t gs_async_running;                                         /**< async running flag */
+static uint8_t gs_async_done;                                            /**< async done flag */
+static uint8_t gs_async_res;                                             /**< async result */
+static uint8_t gs_async_interface;                                       /**< async interface type */
+static uint8_t gs_async_addr;                                            /**< async iic address */
+static uint8_t *gs_async_cmd;                                            /**< async command buffer */
+static uint16_t gs_async_cmd_len;                                        /**< async command length */
+static uint8_t *gs_async_data;                                           /**< async data buffer */
+static uint16_t gs_async_data_len;                                       /**< async data length */
+
+/**
+ * @brief  async transfer
+ * @return status code
+ *         - 0 success
+ *         - 1 write failed
+ * @note   the iic data goes out from the headroom byte before it without a copy
+ */
+static uint8_t a_ssd1306_interface_async_transfer(void)
+{
+    uint8_t res;
+    
+    if (gs_async_interface == SSD1306_INTERFACE_IIC)
+    {
+        res = iic_write(gs_iic_fd, gs_async_addr, 0x00, gs_async_cmd, gs_async_cmd_len);
+        if (res == 0)
+        {
+            gs_async_data[-1] = 0x40;
+            res = iic_write_cmd(gs_iic_fd, gs_async_addr, gs_async_data - 1, gs_async_data_len + 1);
+        }
+    }
+    else
+    {
+        res = wire_write(0);
+        if (res == 0)
+        {
+            res = spi_write_cmd(gs_spi_fd, gs_async_cmd, gs_async_cmd_len);
+        }
+        if (res == 0)
+        {
+            res = wire_write(1);
+        }
+        if (res == 0)
+        {
+            res = spi_write_cmd(gs_spi_fd, gs_async_data, gs_async_data_len);
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     async transfer worker
+ * @param[in] *arg is not used
+ * @return    NULL
+ * @note      the worker lives for the whole process and sleeps between frames
+ */
+static void *a_ssd1306_interface_async_worker(void *arg)
+{
+    uint8_t res;
+    
+    (void)arg;
+    pthread_mutex_lock(&gs_async_mutex);
+    while (1)
+    {
+        while (gs_async_request == 0)
+        {
+            pthread_cond_wait(&gs_async_cond, &gs_async_mutex);
+        }
+        gs_async_request = 0;
+        pthread_mutex_unlock(&gs_async_mutex);
+        res = a_ssd1306_interface_async_transfer();
+        pthread_mutex_lock(&gs_async_mutex);
+        gs_async_res = res;
+        gs_async_done = 1;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     interface async write
+ * @param[in] interface is the interface type
+ * @param[in] addr is the iic device write address
+ * @param[in] *cmd points to a command buffer
+ * @param[in] cmd_len is the command buffer length
+ * @param[in] *data points to a data buffer
+ * @param[in] data_len is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the transfer runs on a worker thread started by the first call
+ */
+uint8_t ssd1306_interface_async_write(uint8_t interface, uint8_t addr, uint8_t *cmd, uint16_t cmd_len,
+                                      uint8_t *data, uint16_t data_len)
+{
+    if (gs_async_running != 0)
+    {
+        return 1;
+    }
+    if (gs_async_started == 0)
+    {
+        if (pthread_create(&gs_async_thread, NULL, a_ssd1306_interface_async_worker, NULL) != 0)
+        {
+            return 1;
+        }
+        (void)pthread_detach(gs_async_thread);
+        gs_async_started = 1;
+    }
+    pthread_mutex_lock(&gs_async_mutex);
+    gs_async_interface = interface;
+    gs_async_addr = addr;
+    gs_async_cmd = cmd;
+    gs_async_cmd_len = cmd_len;
+    gs_async_data = data;
+    gs_async_data_len = data_len;
+    gs_async_done = 0;
+    gs_async_request = 1;
+    pthread_cond_signal(&gs_async_cond);
+    pthread_mutex_unlock(&gs_async_mutex);
+    gs_async_running = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief      interface async poll
+ * @param[out] *busy points to a busy flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the finished transfer failed
+ * @note       none
+ */
+uint8_t ssd1306_interface_async_poll(uint8_t *busy)
+{
+    uint8_t done;
+    uint8_t res;
+    
+    if (gs_async_running == 0)
+    {
+        *busy = 0;
+        
+        return 0;
+    }
+    pthread_mutex_lock(&gs_async_mutex);
+    done = gs_async_done;
+    res = gs_async_res;
+    pthread_mutex_unlock(&gs_async_mutex);
+    if (done == 0)
+    {
+        *busy = 1;
+        
+        return 0;
+    }
+    gs_async_running = 0;
+    *busy = 0;
+    
+    return res;
+}
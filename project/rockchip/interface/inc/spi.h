@@ -54,6 +54,11 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief spi batch definition
+ */
+#define SPI_BATCH_MAX 16        /**< max segments of one batch, the ssd1306 driver queues up to 16 */
+
 /**
  * @brief spi mode type enumeration definition
  */
@@ -138,6 +143,31 @@ uint8_t spi_read_address16(int fd, uint16_t reg, uint8_t *buf, uint16_t len);
  */
 uint8_t spi_write_cmd(int fd, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     spi bus set speed
+ * @param[in] fd is the spi handle
+ * @param[in] freq is the spi running frequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t spi_set_speed(int fd, uint32_t freq);
+
+/**
+ * @brief     spi bus write command batch
+ * @param[in] fd is the spi handle
+ * @param[in] **buf points to the segment buffers
+ * @param[in] *len points to the segment lengths
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      all segments are sent in one ioctl and cs is released between them,
+ *            num must be 1 to SPI_BATCH_MAX
+ */
+uint8_t spi_write_cmd_batch(int fd, uint8_t **buf, uint16_t *len, uint8_t num);
+
 /**
  * @brief     spi bus write
  * @param[in] fd is the spi handle
@@ -281,9 +281,6 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
 	/* clear msgs data */
 	memset(msgs, 0, sizeof(struct i2c_msg) * 1);
 
-	/* clear sent buf */
-	memset(buf_send, 0, sizeof(uint8_t) * (len + 1));
-
 	/* set the param */
 	msgs[0].addr = addr;
 	msgs[0].flags = 0;
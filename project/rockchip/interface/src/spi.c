@@ -322,6 +322,91 @@ uint8_t spi_write_cmd(int fd, uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief     spi bus set speed
+ * @param[in] fd is the spi handle
+ * @param[in] freq is the spi running frequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      none
+ */
+uint8_t spi_set_speed(int fd, uint32_t freq)
+{
+    uint32_t i;
+    
+    /* set the spi write frequence */
+    i = freq;
+    if (ioctl(fd, SPI_IOC_WR_MAX_SPEED_HZ, &i) < 0)
+    {
+        perror("spi: set spi write speed failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the spi read frequence */
+    if (ioctl(fd, SPI_IOC_RD_MAX_SPEED_HZ, &i) < 0)
+    {
+        perror("spi: set spi read speed failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     spi bus write command batch
+ * @param[in] fd is the spi handle
+ * @param[in] **buf points to the segment buffers
+ * @param[in] *len points to the segment lengths
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      all segments are sent in one ioctl and cs is released between them,
+ *            num must be 1 to SPI_BATCH_MAX
+ */
+uint8_t spi_write_cmd_batch(int fd, uint8_t **buf, uint16_t *len, uint8_t num)
+{
+    struct spi_ioc_transfer k[SPI_BATCH_MAX];
+    int total;
+    int l;
+    uint8_t i;
+    
+    /* check the segment number */
+    if ((num == 0) || (num > SPI_BATCH_MAX))
+    {
+        perror("spi: batch number is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* clear ioc transfer */
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * num);
+    
+    /* set the param */
+    total = 0;
+    for (i = 0; i < num; i++)
+    {
+        k[i].tx_buf = (unsigned long)buf[i];
+        k[i].len = len[i];
+        k[i].cs_change = (i + 1 < num) ? 1 : 0;
+        total += len[i];
+    }
+    
+    /* transmit */
+    l = ioctl(fd, SPI_IOC_MESSAGE(num), k);
+    if (l != total)
+    {
+        perror("spi: length check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     spi bus write
  * @param[in] fd is the spi handle
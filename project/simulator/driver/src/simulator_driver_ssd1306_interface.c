@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      simulator_driver_ssd1306_interface.c
+ * @brief     simulator driver ssd1306 interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 199309L /**< clock_gettime and CLOCK_MONOTONIC */
+
+#include "driver_ssd1306_interface.h"
+#include "sim.h"
+#include <stdarg.h>
+#include <time.h>
+
+/**
+ * @brief global var definition
+ */
+static uint64_t gs_delay_us; /**< virtual delay time */
+static uint8_t gs_async_busy; /**< async busy polls left */
+static uint8_t gs_async_res; /**< async result */
+
+/**
+ * @brief  interface iic bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+uint8_t ssd1306_interface_iic_init(void)
+{
+	sim_set_bus(SIM_BUS_IIC);
+
+	return 0;
+}
+
+/**
+ * @brief  interface iic bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+uint8_t ssd1306_interface_iic_deinit(void)
+{
+	return 0;
+}
+
+/**
+ * @brief     interface iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ssd1306_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf,
+				    uint16_t len)
+{
+	uint8_t frame[1 + 2048];
+
+	if (len > 2048) {
+		return 1;
+	}
+	frame[0] = reg;
+	memcpy(&frame[1], buf, len);
+
+	return sim_iic_write(addr, frame, (uint16_t)(len + 1));
+}
+
+/**
+ * @brief     interface iic bus write with headroom
+ * @param[in] addr is the iic device write address
+ * @param[in] *buf points to a data buffer starting with the control byte
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffer goes to the virtual controller without any copy
+ */
+uint8_t ssd1306_interface_iic_write_headroom(uint8_t addr, uint8_t *buf,
+					     uint16_t len)
+{
+	return sim_iic_write(addr, buf, len);
+}
+
+/**
+ * @brief  interface spi bus init
+ * @return status code
+ *         - 0 success
+ *         - 1 spi init failed
+ * @note   the wiring is selected with sim_set_spi_3wire
+ */
+uint8_t ssd1306_interface_spi_init(void)
+{
+	sim_set_bus(SIM_BUS_SPI);
+	sim_set_speed(1000 * 1000 * 2);
+
+	return 0;
+}
+
+/**
+ * @brief  interface spi bus deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 spi deinit failed
+ * @note   none
+ */
+uint8_t ssd1306_interface_spi_deinit(void)
+{
+	return 0;
+}
+
+/**
+ * @brief     interface spi bus write
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ssd1306_interface_spi_write_cmd(uint8_t *buf, uint16_t len)
+{
+	return sim_spi_write(buf, len);
+}
+
+/**
+ * @brief     interface spi bus write batch
+ * @param[in] **buf points to the segment buffers
+ * @param[in] *len points to the segment lengths
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      every segment is one cs frame
+ */
+uint8_t ssd1306_interface_spi_write_batch(uint8_t **buf, uint16_t *len,
+					  uint8_t num)
+{
+	uint8_t i;
+
+	for (i = 0; i < num; i++) {
+		if (sim_spi_write(buf[i], len[i]) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     interface bus set speed
+ * @param[in] interface is the interface in use
+ * @param[in] hz is the bus clock in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the iic clock is not modelled
+ */
+uint8_t ssd1306_interface_bus_set_speed(uint8_t interface, uint32_t hz)
+{
+	if (interface == SSD1306_INTERFACE_IIC) {
+		return 1;
+	}
+	sim_set_speed(hz);
+
+	return 0;
+}
+
+/**
+ * @brief      interface bus read back
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ssd1306_interface_bus_read_back(uint8_t *buf, uint16_t len)
+{
+	return sim_read_back(buf, len);
+}
+
+/**
+ * @brief  interface get the monotonic time
+ * @return time in us
+ * @note   the virtual delay time is added, it may wrap around
+ */
+uint32_t ssd1306_interface_timestamp_us(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (uint32_t)((uint64_t)t.tv_sec * 1000000 + t.tv_nsec / 1000 +
+			  gs_delay_us);
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms
+ * @note      the delay only moves the virtual time so the tests run at once
+ */
+void ssd1306_interface_delay_ms(uint32_t ms)
+{
+	gs_delay_us += (uint64_t)ms * 1000;
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt is the format data
+ * @note      none
+ */
+void ssd1306_interface_debug_print(const char *const fmt, ...)
+{
+	char str[256];
+	uint16_t len;
+	va_list args;
+
+	memset((char *)str, 0, sizeof(char) * 256);
+	va_start(args, fmt);
+	vsnprintf((char *)str, 255, (char const *)fmt, args);
+	va_end(args);
+
+	len = strlen((char *)str);
+	(void)fwrite(str, 1, len, stdout);
+}
+
+/**
+ * @brief  interface command && data gpio init
+ * @return status code
+ *         - 0 success
+ *         - 1 gpio init failed
+ * @note   none
+ */
+uint8_t ssd1306_interface_spi_cmd_data_gpio_init(void)
+{
+	return 0;
+}
+
+/**
+ * @brief  interface command && data gpio deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 gpio deinit failed
+ * @note   none
+ */
+uint8_t ssd1306_interface_spi_cmd_data_gpio_deinit(void)
+{
+	return 0;
+}
+
+/**
+ * @brief     interface command && data gpio write
+ * @param[in] value is the written value
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio write failed
+ * @note      none
+ */
+uint8_t ssd1306_interface_spi_cmd_data_gpio_write(uint8_t value)
+{
+	return sim_dc_write(value);
+}
+
+/**
+ * @brief  interface reset gpio init
+ * @return status code
+ *         - 0 success
+ *         - 1 gpio init failed
+ * @note   none
+ */
+uint8_t ssd1306_interface_reset_gpio_init(void)
+{
+	return 0;
+}
+
+/**
+ * @brief  interface reset gpio deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 gpio deinit failed
+ * @note   none
+ */
+uint8_t ssd1306_interface_reset_gpio_deinit(void)
+{
+	return 0;
+}
+
+/**
+ * @brief     interface reset gpio write
+ * @param[in] value is the written value
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio write failed
+ * @note      none
+ */
+uint8_t ssd1306_interface_reset_gpio_write(uint8_t value)
+{
+	return sim_reset_write(value);
+}
+
+/**
+ * @brief     interface async write
+ * @param[in] interface is the interface type
+ * @param[in] addr is the iic device write address
+ * @param[in] *cmd points to a command buffer
+ * @param[in] cmd_len is the command buffer length
+ * @param[in] *data points to a data buffer
+ * @param[in] data_len is the data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the transfer is decoded at once and reported busy for the first poll, the iic data is sent from
+ *            the headroom byte before it
+ */
+uint8_t ssd1306_interface_async_write(uint8_t interface, uint8_t addr,
+				      uint8_t *cmd, uint16_t cmd_len,
+				      uint8_t *data, uint16_t data_len)
+{
+	uint8_t res;
+
+	if (gs_async_busy != 0) {
+		return 1;
+	}
+	if (interface == SSD1306_INTERFACE_IIC) {
+		res = ssd1306_interface_iic_write(addr, 0x00, cmd, cmd_len);
+		if (res == 0) {
+			data[-1] = 0x40;
+			res = ssd1306_interface_iic_write_headroom(
+				addr, data - 1, data_len + 1);
+		}
+	} else {
+		res = sim_dc_write(0);
+		if (res == 0) {
+			res = sim_spi_write(cmd, cmd_len);
+		}
+		if (res == 0) {
+			res = sim_dc_write(1);
+		}
+		if (res == 0) {
+			res = sim_spi_write(data, data_len);
+		}
+	}
+	gs_async_res = res;
+	gs_async_busy = 1;
+
+	return 0;
+}
+
+/**
+ * @brief      interface async poll
+ * @param[out] *busy points to a busy flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the finished transfer failed
+ * @note       none
+ */
+uint8_t ssd1306_interface_async_poll(uint8_t *busy)
+{
+	static uint8_t polled;
+
+	if (gs_async_busy == 0) {
+		*busy = 0;
+
+		return 0;
+	}
+	if (polled == 0) {
+		polled = 1;
+		*busy = 1;
+
+		return 0;
+	}
+	polled = 0;
+	gs_async_busy = 0;
+	*busy = 0;
+
+	return gs_async_res;
+}
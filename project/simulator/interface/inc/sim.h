@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      sim.h
+ * @brief     sim header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup sim sim function
+ * @brief    virtual ssd1306 controller modules
+ * @{
+ */
+
+/**
+ * @brief sim max stable spi clock definition
+ */
+#define SIM_SPI_MAX_HZ 10000000        /**< 100ns serial clock cycle time of the datasheet */
+
+/**
+ * @brief sim bus enumeration definition
+ */
+typedef enum
+{
+    SIM_BUS_IIC = 0x00,        /**< iic with control bytes */
+    SIM_BUS_SPI = 0x01,        /**< spi */
+} sim_bus_t;
+
+/**
+ * @brief sim counter structure definition
+ */
+typedef struct sim_counter_s
+{
+    uint32_t transaction;        /**< iic start stop pairs or spi cs frames */
+    uint32_t byte;               /**< bytes on the wire including the iic address and control bytes */
+    uint32_t command;            /**< decoded command and parameter bytes */
+    uint32_t data;               /**< decoded gram data bytes */
+    uint32_t gpio;               /**< command data gpio writes */
+    uint32_t error;              /**< protocol errors */
+} sim_counter_t;
+
+/**
+ * @brief sim state structure definition
+ */
+typedef struct sim_state_s
+{
+    uint8_t ram[8][128];              /**< gram as [page][column] */
+    uint8_t addressing_mode;          /**< 0 horizontal, 1 vertical, 2 page */
+    uint8_t column;                   /**< column pointer */
+    uint8_t page;                     /**< page pointer */
+    uint8_t column_start;             /**< column range start */
+    uint8_t column_end;               /**< column range end */
+    uint8_t page_start;               /**< page range start */
+    uint8_t page_end;                 /**< page range end */
+    uint8_t start_line;               /**< display start line */
+    uint8_t offset;                   /**< display offset */
+    uint8_t multiplex;                /**< multiplex ratio minus 1 */
+    uint8_t contrast;                 /**< contrast */
+    uint8_t segment_remap;            /**< 1 if column 127 is mapped to seg0 */
+    uint8_t scan_remap;               /**< 1 if com scans from com[n-1] */
+    uint8_t com_pins;                 /**< com pins hardware conf */
+    uint8_t clock;                    /**< display clock divide */
+    uint8_t precharge;                /**< pre charge period */
+    uint8_t vcomh;                    /**< vcomh deselect level */
+    uint8_t charge_pump;              /**< charge pump setting */
+    uint8_t display_on;               /**< 1 if display on */
+    uint8_t entire_on;                /**< 1 if entire display on */
+    uint8_t inverse;                  /**< 1 if inverse display */
+    uint8_t scroll_active;            /**< 1 if the scroll is activated */
+    uint8_t scroll[7];                /**< last scroll setup command and parameters */
+    uint8_t scroll_area[2];           /**< vertical scroll area */
+    uint8_t fade;                     /**< fade out and blinking setting */
+    uint8_t zoom;                     /**< zoom in setting */
+} sim_state_t;
+
+/**
+ * @brief  reset the controller to the power on state
+ * @note   the gram keeps its content like the real chip
+ */
+void sim_reset(void);
+
+/**
+ * @brief     set the bus
+ * @param[in] bus is the bus type
+ * @note      the interface init functions select it
+ */
+void sim_set_bus(sim_bus_t bus);
+
+/**
+ * @brief     set the spi wiring
+ * @param[in] enable is 1 for 3-wire spi with 9-bit words and 0 for 4-wire spi with the command data gpio
+ * @note      both spi wirings share the same interface functions, so the wiring is kept across inits
+ */
+void sim_set_spi_3wire(uint8_t enable);
+
+/**
+ * @brief     write an iic transaction
+ * @param[in] addr is the iic device address
+ * @param[in] *buf points to a buffer starting with the control byte
+ * @param[in] len is the buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 the address is not acknowledged
+ * @note      none
+ */
+uint8_t sim_iic_write(uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     write a spi cs frame
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the buffer length
+ * @return    status code
+ *            - 0 success
+ * @note      the bytes are decoded as 9-bit words in 3-wire spi
+ */
+uint8_t sim_spi_write(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     write the command data gpio
+ * @param[in] value is the gpio level
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t sim_dc_write(uint8_t value);
+
+/**
+ * @brief     write the reset gpio
+ * @param[in] value is the gpio level
+ * @return    status code
+ *            - 0 success
+ * @note      a low level resets the controller
+ */
+uint8_t sim_reset_write(uint8_t value);
+
+/**
+ * @brief     set the spi clock
+ * @param[in] hz is the spi clock in hz
+ * @note      the loopback echo is corrupted above SIM_SPI_MAX_HZ
+ */
+void sim_set_speed(uint32_t hz);
+
+/**
+ * @brief      read back the last spi bytes from the loopback
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 len is over 256
+ * @note       none
+ */
+uint8_t sim_read_back(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      get the counters
+ * @param[out] *counter points to a counter structure
+ * @note       none
+ */
+void sim_get_counter(sim_counter_t *counter);
+
+/**
+ * @brief  clear the counters
+ * @note   none
+ */
+void sim_clear_counter(void);
+
+/**
+ * @brief  get the controller state
+ * @return points to the state structure
+ * @note   none
+ */
+const sim_state_t *sim_get_state(void);
+
+/**
+ * @brief      render the panel as it is lit
+ * @param[out] pixel is the 64 x 128 panel buffer
+ * @note       the panel is wired like the common modules with com63 on the top row and seg127 on the left column,
+ *             so segment remap and com scan remap show the gram upright, start line, offset, multiplex, inverse,
+ *             entire on and display on are applied, the com pins conf is taken as the panel wiring and scroll,
+ *             fade and zoom are not animated
+ */
+void sim_render(uint8_t pixel[64][128]);
+
+/**
+ * @brief     save the rendered panel
+ * @param[in] *path points to a pgm file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 save failed
+ * @note      lit pixels get the contrast as the gray level and the last lit panel is saved if the display is off
+ */
+uint8_t sim_save_pgm(const char *path);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,639 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      sim.c
+ * @brief     sim source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "sim.h"
+#include <string.h>
+
+/**
+ * @brief sim iic address definition
+ */
+#define SIM_IIC_ADDR_SA0_0 0x3C /**< address pin GND */
+#define SIM_IIC_ADDR_SA0_1 0x3D /**< address pin VCC */
+
+/**
+ * @brief global var definition
+ */
+static sim_state_t gs_state; /**< controller state */
+static sim_counter_t gs_counter; /**< counters */
+static sim_bus_t gs_bus; /**< bus */
+static uint8_t gs_spi_3wire; /**< 3-wire spi flag */
+static uint8_t gs_dc; /**< command data gpio level */
+static uint8_t gs_cmd[8]; /**< command being decoded */
+static uint8_t gs_cmd_len; /**< decoded command length */
+static uint8_t gs_cmd_need; /**< full command length */
+static uint32_t gs_speed; /**< spi clock */
+static uint8_t gs_echo[256]; /**< loopback ring */
+static uint8_t gs_echo_pos; /**< loopback ring position */
+static uint8_t gs_last[64][128]; /**< last lit panel */
+
+/**
+ * @brief     get the parameter number of a command
+ * @param[in] cmd is the command byte
+ * @return    parameter number
+ * @note      none
+ */
+static uint8_t a_sim_param_num(uint8_t cmd)
+{
+	switch (cmd) {
+	case 0x20:
+	case 0x23:
+	case 0x81:
+	case 0x8D:
+	case 0xA8:
+	case 0xD3:
+	case 0xD5:
+	case 0xD6:
+	case 0xD9:
+	case 0xDA:
+	case 0xDB:
+		return 1;
+	case 0x21:
+	case 0x22:
+	case 0xA3:
+		return 2;
+	case 0x29:
+	case 0x2A:
+		return 5;
+	case 0x26:
+	case 0x27:
+		return 6;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief  run the decoded command
+ * @note   none
+ */
+static void a_sim_run_command(void)
+{
+	uint8_t cmd;
+
+	cmd = gs_cmd[0];
+	if (cmd <= 0x0F) {
+		/* lower column in page mode */
+		gs_state.column = (uint8_t)((gs_state.column & 0xF0) | cmd);
+	} else if (cmd <= 0x1F) {
+		/* higher column in page mode */
+		gs_state.column =
+			(uint8_t)((gs_state.column & 0x0F) | ((cmd & 0x07) << 4));
+	} else if ((cmd >= 0x40) && (cmd <= 0x7F)) {
+		gs_state.start_line = cmd & 0x3F;
+	} else if ((cmd >= 0xB0) && (cmd <= 0xB7)) {
+		gs_state.page = cmd & 0x07;
+	} else {
+		switch (cmd) {
+		case 0x20:
+			if ((gs_cmd[1] & 0x03) == 0x03) {
+				gs_counter.error++;
+			} else {
+				gs_state.addressing_mode = gs_cmd[1] & 0x03;
+			}
+			break;
+		case 0x21:
+			gs_state.column_start = gs_cmd[1] & 0x7F;
+			gs_state.column_end = gs_cmd[2] & 0x7F;
+			gs_state.column = gs_state.column_start;
+			break;
+		case 0x22:
+			gs_state.page_start = gs_cmd[1] & 0x07;
+			gs_state.page_end = gs_cmd[2] & 0x07;
+			gs_state.page = gs_state.page_start;
+			break;
+		case 0x23:
+			gs_state.fade = gs_cmd[1];
+			break;
+		case 0x26:
+		case 0x27:
+		case 0x29:
+		case 0x2A:
+			memcpy(gs_state.scroll, gs_cmd, sizeof(gs_state.scroll));
+			break;
+		case 0x2E:
+			gs_state.scroll_active = 0;
+			break;
+		case 0x2F:
+			gs_state.scroll_active = 1;
+			break;
+		case 0x81:
+			gs_state.contrast = gs_cmd[1];
+			break;
+		case 0x8D:
+			gs_state.charge_pump = gs_cmd[1];
+			break;
+		case 0xA0:
+		case 0xA1:
+			gs_state.segment_remap = cmd & 0x01;
+			break;
+		case 0xA3:
+			gs_state.scroll_area[0] = gs_cmd[1];
+			gs_state.scroll_area[1] = gs_cmd[2];
+			break;
+		case 0xA4:
+		case 0xA5:
+			gs_state.entire_on = cmd & 0x01;
+			break;
+		case 0xA6:
+		case 0xA7:
+			gs_state.inverse = cmd & 0x01;
+			break;
+		case 0xA8:
+			if ((gs_cmd[1] & 0x3F) < 15) {
+				gs_counter.error++;
+			} else {
+				gs_state.multiplex = gs_cmd[1] & 0x3F;
+			}
+			break;
+		case 0xAE:
+		case 0xAF:
+			if ((gs_state.display_on != 0) && (cmd == 0xAE)) {
+				/* keep the panel shown before it goes off */
+				sim_render(gs_last);
+			}
+			gs_state.display_on = cmd & 0x01;
+			break;
+		case 0xC0:
+			gs_state.scan_remap = 0;
+			break;
+		case 0xC8:
+			gs_state.scan_remap = 1;
+			break;
+		case 0xD3:
+			gs_state.offset = gs_cmd[1] & 0x3F;
+			break;
+		case 0xD5:
+			gs_state.clock = gs_cmd[1];
+			break;
+		case 0xD6:
+			gs_state.zoom = gs_cmd[1];
+			break;
+		case 0xD9:
+			gs_state.precharge = gs_cmd[1];
+			break;
+		case 0xDA:
+			gs_state.com_pins = gs_cmd[1];
+			break;
+		case 0xDB:
+			gs_state.vcomh = gs_cmd[1];
+			break;
+		case 0xE3:
+			break;
+		default:
+			gs_counter.error++;
+			break;
+		}
+	}
+}
+
+/**
+ * @brief     decode a command byte
+ * @param[in] byte is the command byte
+ * @note      parameters may come in later transactions like on the chip
+ */
+static void a_sim_command(uint8_t byte)
+{
+	gs_counter.command++;
+	if (gs_cmd_need == 0) {
+		gs_cmd_len = 0;
+		gs_cmd_need = (uint8_t)(1 + a_sim_param_num(byte));
+	}
+	gs_cmd[gs_cmd_len++] = byte;
+	if (gs_cmd_len == gs_cmd_need) {
+		gs_cmd_need = 0;
+		a_sim_run_command();
+	}
+}
+
+/**
+ * @brief     decode a data byte
+ * @param[in] byte is the data byte
+ * @note      the pointers move as the addressing mode defines
+ */
+static void a_sim_data(uint8_t byte)
+{
+	gs_counter.data++;
+	if (gs_cmd_need != 0) {
+		/* a command is cut by data */
+		gs_counter.error++;
+		gs_cmd_need = 0;
+	}
+	gs_state.ram[gs_state.page & 0x07][gs_state.column & 0x7F] = byte;
+	if (gs_state.addressing_mode == 0) {
+		/* horizontal */
+		if (gs_state.column >= gs_state.column_end) {
+			gs_state.column = gs_state.column_start;
+			if (gs_state.page >= gs_state.page_end) {
+				gs_state.page = gs_state.page_start;
+			} else {
+				gs_state.page++;
+			}
+		} else {
+			gs_state.column++;
+		}
+	} else if (gs_state.addressing_mode == 1) {
+		/* vertical */
+		if (gs_state.page >= gs_state.page_end) {
+			gs_state.page = gs_state.page_start;
+			if (gs_state.column >= gs_state.column_end) {
+				gs_state.column = gs_state.column_start;
+			} else {
+				gs_state.column++;
+			}
+		} else {
+			gs_state.page++;
+		}
+	} else {
+		/* page, the column wraps and the page stays */
+		gs_state.column = (uint8_t)((gs_state.column + 1) & 0x7F);
+	}
+}
+
+/**
+ * @brief     save a byte in the loopback ring
+ * @param[in] byte is the wire byte
+ * @note      the echo is corrupted above SIM_SPI_MAX_HZ
+ */
+static void a_sim_echo(uint8_t byte)
+{
+	if (gs_speed > SIM_SPI_MAX_HZ) {
+		byte ^= 0x10;
+	}
+	gs_echo[gs_echo_pos++] = byte;
+}
+
+/**
+ * @brief  reset the controller to the power on state
+ * @note   the gram keeps its content like the real chip
+ */
+void sim_reset(void)
+{
+	uint8_t ram[8][128];
+
+	memcpy(ram, gs_state.ram, sizeof(ram));
+	memset(&gs_state, 0, sizeof(gs_state));
+	memcpy(gs_state.ram, ram, sizeof(ram));
+	gs_state.addressing_mode = 2;
+	gs_state.column_end = 127;
+	gs_state.page_end = 7;
+	gs_state.multiplex = 63;
+	gs_state.contrast = 0x7F;
+	gs_state.com_pins = 0x12;
+	gs_state.clock = 0x80;
+	gs_state.precharge = 0x22;
+	gs_state.vcomh = 0x20;
+	gs_state.charge_pump = 0x10;
+	gs_cmd_len = 0;
+	gs_cmd_need = 0;
+}
+
+/**
+ * @brief     set the bus
+ * @param[in] bus is the bus type
+ * @note      the interface init functions select it
+ */
+void sim_set_bus(sim_bus_t bus)
+{
+	gs_bus = bus;
+}
+
+/**
+ * @brief     set the spi wiring
+ * @param[in] enable is 1 for 3-wire spi with 9-bit words and 0 for 4-wire spi with the command data gpio
+ * @note      both spi wirings share the same interface functions, so the wiring is kept across inits
+ */
+void sim_set_spi_3wire(uint8_t enable)
+{
+	gs_spi_3wire = enable;
+}
+
+/**
+ * @brief     write an iic transaction
+ * @param[in] addr is the iic device address
+ * @param[in] *buf points to a buffer starting with the control byte
+ * @param[in] len is the buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 the address is not acknowledged
+ * @note      none
+ */
+uint8_t sim_iic_write(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+	uint16_t i;
+	uint8_t control;
+	uint8_t single;
+
+	gs_counter.transaction++;
+	gs_counter.byte++;
+	if ((gs_bus != SIM_BUS_IIC) ||
+	    ((addr != SIM_IIC_ADDR_SA0_0) && (addr != SIM_IIC_ADDR_SA0_1))) {
+		gs_counter.error++;
+
+		return 1;
+	}
+	gs_counter.byte += len;
+	i = 0;
+	while (i < len) {
+		/* the control byte */
+		control = buf[i++];
+		single = control & 0x80;
+		if ((control & 0x3F) != 0) {
+			gs_counter.error++;
+		}
+		if (i == len) {
+			break;
+		}
+		if (single != 0) {
+			/* co set, one byte then the next control byte */
+			if ((control & 0x40) != 0) {
+				a_sim_data(buf[i++]);
+			} else {
+				a_sim_command(buf[i++]);
+			}
+		} else {
+			/* co clear, the rest of the transaction */
+			while (i < len) {
+				if ((control & 0x40) != 0) {
+					a_sim_data(buf[i++]);
+				} else {
+					a_sim_command(buf[i++]);
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     write a spi cs frame
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the buffer length
+ * @return    status code
+ *            - 0 success
+ * @note      the bytes are decoded as 9-bit words in 3-wire spi
+ */
+uint8_t sim_spi_write(uint8_t *buf, uint16_t len)
+{
+	uint32_t acc;
+	uint16_t i;
+	uint16_t word;
+	uint8_t bits;
+
+	gs_counter.transaction++;
+	gs_counter.byte += len;
+	for (i = 0; i < len; i++) {
+		a_sim_echo(buf[i]);
+	}
+	if (gs_bus != SIM_BUS_SPI) {
+		gs_counter.error++;
+	} else if (gs_spi_3wire == 0) {
+		for (i = 0; i < len; i++) {
+			if (gs_dc != 0) {
+				a_sim_data(buf[i]);
+			} else {
+				a_sim_command(buf[i]);
+			}
+		}
+	} else {
+		acc = 0;
+		bits = 0;
+		for (i = 0; i < len; i++) {
+			acc = (acc << 8) | buf[i];
+			bits += 8;
+			if (bits >= 9) {
+				bits -= 9;
+				word = (uint16_t)((acc >> bits) & 0x1FF);
+				acc &= (1U << bits) - 1;
+				if ((word & 0x100) != 0) {
+					a_sim_data((uint8_t)word);
+				} else {
+					a_sim_command((uint8_t)word);
+				}
+			}
+		}
+		/* the bits left are dropped when cs rises */
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     write the command data gpio
+ * @param[in] value is the gpio level
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t sim_dc_write(uint8_t value)
+{
+	gs_counter.gpio++;
+	gs_dc = value;
+
+	return 0;
+}
+
+/**
+ * @brief     write the reset gpio
+ * @param[in] value is the gpio level
+ * @return    status code
+ *            - 0 success
+ * @note      a low level resets the controller
+ */
+uint8_t sim_reset_write(uint8_t value)
+{
+	if (value == 0) {
+		sim_reset();
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     set the spi clock
+ * @param[in] hz is the spi clock in hz
+ * @note      the loopback echo is corrupted above SIM_SPI_MAX_HZ
+ */
+void sim_set_speed(uint32_t hz)
+{
+	gs_speed = hz;
+}
+
+/**
+ * @brief      read back the last spi bytes from the loopback
+ * @param[out] *buf points to a data buffer
+ * @param[in]  len is the data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 len is over 256
+ * @note       none
+ */
+uint8_t sim_read_back(uint8_t *buf, uint16_t len)
+{
+	uint16_t i;
+
+	if (len > sizeof(gs_echo)) {
+		return 1;
+	}
+	for (i = 0; i < len; i++) {
+		buf[i] = gs_echo[(uint8_t)(gs_echo_pos - len + i)];
+	}
+
+	return 0;
+}
+
+/**
+ * @brief      get the counters
+ * @param[out] *counter points to a counter structure
+ * @note       none
+ */
+void sim_get_counter(sim_counter_t *counter)
+{
+	*counter = gs_counter;
+}
+
+/**
+ * @brief  clear the counters
+ * @note   none
+ */
+void sim_clear_counter(void)
+{
+	memset(&gs_counter, 0, sizeof(gs_counter));
+}
+
+/**
+ * @brief  get the controller state
+ * @return points to the state structure
+ * @note   none
+ */
+const sim_state_t *sim_get_state(void)
+{
+	return &gs_state;
+}
+
+/**
+ * @brief      render the panel as it is lit
+ * @param[out] pixel is the 64 x 128 panel buffer
+ * @note       the panel is wired like the common modules with com63 on the top row and seg127 on the left column,
+ *             so segment remap and com scan remap show the gram upright, start line, offset, multiplex, inverse,
+ *             entire on and display on are applied, the com pins conf is taken as the panel wiring and scroll,
+ *             fade and zoom are not animated
+ */
+void sim_render(uint8_t pixel[64][128])
+{
+	uint8_t row;
+	uint8_t col;
+	uint8_t com;
+	uint8_t line;
+	uint8_t seg;
+	uint8_t on;
+
+	for (row = 0; row < 64; row++) {
+		/* com63 is the top row */
+		com = (uint8_t)(63 - row);
+		for (col = 0; col < 128; col++) {
+			if ((gs_state.display_on == 0) ||
+			    (com > gs_state.multiplex)) {
+				/* the row is not driven */
+				pixel[row][col] = 0;
+
+				continue;
+			}
+			if (gs_state.scan_remap != 0) {
+				line = (uint8_t)(gs_state.multiplex - com);
+			} else {
+				line = com;
+			}
+			line = (uint8_t)((line + gs_state.start_line +
+					  gs_state.offset) &
+					 0x3F);
+
+			/* seg127 is the left column */
+			seg = (uint8_t)(127 - col);
+			if (gs_state.segment_remap != 0) {
+				seg = (uint8_t)(127 - seg);
+			}
+			if (gs_state.entire_on != 0) {
+				on = 1;
+			} else {
+				on = (gs_state.ram[line >> 3][seg] >> (line & 0x07)) &
+				     0x01;
+			}
+			pixel[row][col] = on ^ gs_state.inverse;
+		}
+	}
+}
+
+/**
+ * @brief     save the rendered panel
+ * @param[in] *path points to a pgm file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 save failed
+ * @note      lit pixels get the contrast as the gray level and the last lit panel is saved if the display is off
+ */
+uint8_t sim_save_pgm(const char *path)
+{
+	static uint8_t pixel[64][128];
+	FILE *fp;
+	uint8_t row;
+	uint8_t col;
+	uint8_t gray;
+
+	fp = fopen(path, "wb");
+	if (fp == NULL) {
+		perror("sim: open failed.\n");
+
+		return 1;
+	}
+	if (gs_state.display_on != 0) {
+		sim_render(pixel);
+	} else {
+		memcpy(pixel, gs_last, sizeof(pixel));
+	}
+	gray = (gs_state.contrast < 0x40) ? 0x40 : gs_state.contrast;
+	(void)fprintf(fp, "P5\n128 64\n255\n");
+	for (row = 0; row < 64; row++) {
+		for (col = 0; col < 128; col++) {
+			(void)fputc((pixel[row][col] != 0) ? gray : 0, fp);
+		}
+	}
+	if (fclose(fp) != 0) {
+		return 1;
+	}
+
+	return 0;
+}
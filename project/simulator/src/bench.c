@@ -0,0 +1,579 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      bench.c
+ * @brief     bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ssd1306_basic.h"
+#include "driver_ssd1306_interface.h"
+#include "sim.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+/**
+ * @brief bench max result definition
+ */
+#define BENCH_MAX_RESULT 256 /**< max recorded scenarios */
+
+/**
+ * @brief bench result structure definition
+ */
+typedef struct bench_result_s {
+	char interface[8]; /**< interface name */
+	char transport[16]; /**< iic transport name */
+	char flush[8]; /**< flush mode name */
+	char scenario[24]; /**< scenario name */
+	sim_counter_t counter; /**< bus counters */
+} bench_result_t;
+
+/**
+ * @brief bench bus structure definition
+ */
+typedef struct bench_bus_s {
+	const char *name; /**< interface name */
+	ssd1306_interface_t interface; /**< driver interface */
+	uint8_t spi_3wire; /**< 1 for 3-wire spi */
+	uint32_t hz[3]; /**< modelled bus clocks */
+} bench_bus_t;
+
+/**
+ * @brief global var definition
+ */
+static ssd1306_handle_t gs_handle; /**< ssd1306 handle */
+static bench_result_t gs_result[BENCH_MAX_RESULT]; /**< recorded scenarios */
+static uint16_t gs_result_num; /**< recorded scenario number */
+static uint8_t gs_img[32 * 32]; /**< picture with one byte per pixel */
+static const bench_bus_t gs_bus[] = {
+	{ "iic", SSD1306_INTERFACE_IIC, 0, { 100000, 400000, 1000000 } },
+	{ "spi", SSD1306_INTERFACE_SPI, 0, { 2000000, 8000000, 10000000 } },
+#if (SSD1306_SPI_3WIRE == 1)
+	{ "spi3", SSD1306_INTERFACE_SPI_3WIRE, 1, { 2000000, 8000000, 10000000 } },
+#endif
+}; /**< benchmarked buses */
+static const char *const gs_flush_name[3] = { "page", "byte", "frame" }; /**< flush mode names */
+
+/**
+ * @brief     estimate the wire time of the counted traffic
+ * @param[in] *counter points to a counter structure
+ * @param[in] interface is the interface type
+ * @param[in] hz is the bus clock
+ * @return    time in us
+ * @note      iic sends 9 clocks per byte with the ack and about 2 clocks for the start and the stop,
+ *            spi sends 8 clocks per byte and about 1 clock of cs setup and hold per frame,
+ *            the gpio writes and the host gaps are not modelled
+ */
+static double a_bench_time_us(const sim_counter_t *counter,
+			      ssd1306_interface_t interface, uint32_t hz)
+{
+	double bits;
+
+	if (interface == SSD1306_INTERFACE_IIC) {
+		bits = (double)counter->byte * 9.0 +
+		       (double)counter->transaction * 2.0;
+	} else {
+		bits = (double)counter->byte * 8.0 +
+		       (double)counter->transaction * 1.0;
+	}
+
+	return bits * 1000000.0 / (double)hz;
+}
+
+/**
+ * @brief     record the counters of a scenario
+ * @param[in] *bus points to a bench bus structure
+ * @param[in] *transport points to a transport name
+ * @param[in] *flush points to a flush mode name
+ * @param[in] *scenario points to a scenario name
+ * @return    status code
+ *            - 0 success
+ *            - 1 record failed
+ * @note      the counters are cleared after recording
+ */
+static uint8_t a_bench_record(const bench_bus_t *bus, const char *transport,
+			      const char *flush, const char *scenario)
+{
+	bench_result_t *result;
+	uint32_t payload;
+	uint8_t i;
+
+	if (gs_result_num >= BENCH_MAX_RESULT) {
+		fprintf(stderr, "bench: too many scenarios.\n");
+
+		return 1;
+	}
+	result = &gs_result[gs_result_num];
+	snprintf(result->interface, sizeof(result->interface), "%s",
+		 bus->name);
+	snprintf(result->transport, sizeof(result->transport), "%s",
+		 transport);
+	snprintf(result->flush, sizeof(result->flush), "%s", flush);
+	snprintf(result->scenario, sizeof(result->scenario), "%s", scenario);
+	sim_get_counter(&result->counter);
+	sim_clear_counter();
+	if (result->counter.error != 0) {
+		fprintf(stderr, "bench: %s %s %s %s has protocol errors.\n",
+			bus->name, transport, flush, scenario);
+
+		return 1;
+	}
+	gs_result_num++;
+
+	/* one row per modelled clock */
+	payload = result->counter.command + result->counter.data;
+	for (i = 0; i < 3; i++) {
+		printf("%s,%s,%s,%s,%u,%u,%u,%u,%u,%.1f\n", result->interface,
+		       result->transport, result->flush, result->scenario,
+		       result->counter.transaction, payload,
+		       result->counter.byte - payload, result->counter.gpio,
+		       bus->hz[i],
+		       a_bench_time_us(&result->counter, bus->interface,
+				       bus->hz[i]));
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     run the basic example scenarios
+ * @param[in] *bus points to a bench bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the basic example uses the page flush mode and the separate iic transport
+ */
+static uint8_t a_bench_basic(const bench_bus_t *bus)
+{
+	const char *transport;
+	char str[] = "12:34";
+
+	transport = (bus->interface == SSD1306_INTERFACE_IIC) ? "separate" :
+								  "none";
+	sim_reset();
+	sim_set_spi_3wire(bus->spi_3wire);
+	sim_clear_counter();
+	if ((ssd1306_basic_init(bus->interface, SSD1306_ADDR_SA0_0) != 0) ||
+	    (a_bench_record(bus, transport, "page", "basic_init") != 0)) {
+		return 1;
+	}
+	if ((ssd1306_basic_clear() != 0) ||
+	    (a_bench_record(bus, transport, "page", "basic_clear") != 0) ||
+	    (ssd1306_basic_write_point(64, 32, 1) != 0) ||
+	    (a_bench_record(bus, transport, "page", "basic_point") != 0) ||
+	    (ssd1306_basic_string(0, 0, str, 5, 1, SSD1306_FONT_16) != 0) ||
+	    (a_bench_record(bus, transport, "page", "basic_string") != 0) ||
+	    (ssd1306_basic_rect(32, 16, 95, 47, 1) != 0) ||
+	    (a_bench_record(bus, transport, "page", "basic_rect") != 0) ||
+	    (ssd1306_basic_picture(48, 16, 79, 47, gs_img) != 0) ||
+	    (a_bench_record(bus, transport, "page", "basic_picture") != 0)) {
+		(void)ssd1306_basic_deinit();
+
+		return 1;
+	}
+
+	return ssd1306_basic_deinit();
+}
+
+/**
+ * @brief     run the handle scenarios with one flush mode
+ * @param[in] *bus points to a bench bus structure
+ * @param[in] *transport points to a transport name
+ * @param[in] mode is the flush mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      every scenario starts from a flushed gram
+ */
+static uint8_t a_bench_flush(const bench_bus_t *bus, const char *transport,
+			     ssd1306_flush_mode_t mode)
+{
+	ssd1306_point_t point[128];
+	const char *flush;
+	char str1[] = "12:34";
+	char str2[] = "12:35";
+	uint8_t i;
+
+	flush = gs_flush_name[mode];
+	for (i = 0; i < 128; i++) {
+		point[i].x = i;
+		point[i].y = (int16_t)((i % 32 < 16) ? (i % 32) * 4 :
+						       (31 - i % 32) * 4);
+	}
+	if (ssd1306_set_flush_mode(&gs_handle, mode) != 0) {
+		return 1;
+	}
+
+	/* full update */
+	(void)ssd1306_clear(&gs_handle);
+	(void)ssd1306_gram_fill_rect(&gs_handle, 0, 0, 127, 63, 1);
+	sim_clear_counter();
+	if ((ssd1306_gram_update(&gs_handle) != 0) ||
+	    (a_bench_record(bus, transport, flush, "update") != 0)) {
+		return 1;
+	}
+
+	/* clear */
+	if ((ssd1306_clear(&gs_handle) != 0) ||
+	    (a_bench_record(bus, transport, flush, "clear") != 0)) {
+		return 1;
+	}
+
+	/* single point */
+	if ((ssd1306_write_point(&gs_handle, 64, 32, 1) != 0) ||
+	    (a_bench_record(bus, transport, flush, "point") != 0)) {
+		return 1;
+	}
+
+	/* point wave */
+	(void)ssd1306_clear(&gs_handle);
+	sim_clear_counter();
+	for (i = 0; i < 128; i++) {
+		if (ssd1306_write_point(&gs_handle, (uint8_t)point[i].x,
+					(uint8_t)point[i].y, 1) != 0) {
+			return 1;
+		}
+	}
+	if (a_bench_record(bus, transport, flush, "point_wave") != 0) {
+		return 1;
+	}
+	(void)ssd1306_clear(&gs_handle);
+	sim_clear_counter();
+	if ((ssd1306_write_points(&gs_handle, point, 128, 1) != 0) ||
+	    (a_bench_record(bus, transport, flush, "points_wave") != 0)) {
+		return 1;
+	}
+
+	/* string, rect and picture with the dirty update */
+	(void)ssd1306_clear(&gs_handle);
+	sim_clear_counter();
+	if ((ssd1306_gram_write_string(&gs_handle, 0, 0, str1, 5, 1,
+				       SSD1306_FONT_16) != 0) ||
+	    (ssd1306_gram_update_dirty(&gs_handle) != 0) ||
+	    (a_bench_record(bus, transport, flush, "string_dirty") != 0)) {
+		return 1;
+	}
+	if ((ssd1306_gram_fill_rect(&gs_handle, 32, 16, 95, 47, 1) != 0) ||
+	    (ssd1306_gram_update_dirty(&gs_handle) != 0) ||
+	    (a_bench_record(bus, transport, flush, "rect_dirty") != 0)) {
+		return 1;
+	}
+	if ((ssd1306_gram_draw_picture(&gs_handle, 48, 16, 79, 47, gs_img) !=
+	     0) ||
+	    (ssd1306_gram_update_dirty(&gs_handle) != 0) ||
+	    (a_bench_record(bus, transport, flush, "picture_dirty") != 0)) {
+		return 1;
+	}
+
+	/* one digit changed with the diff update */
+	(void)ssd1306_clear(&gs_handle);
+	(void)ssd1306_gram_write_string(&gs_handle, 0, 0, str1, 5, 1,
+					SSD1306_FONT_16);
+	(void)ssd1306_gram_update(&gs_handle);
+	sim_clear_counter();
+	if ((ssd1306_gram_write_string(&gs_handle, 0, 0, str2, 5, 1,
+				       SSD1306_FONT_16) != 0) ||
+	    (ssd1306_gram_update_diff(&gs_handle) != 0) ||
+	    (a_bench_record(bus, transport, flush, "string_diff") != 0)) {
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     run the handle scenarios of a bus
+ * @param[in] *bus points to a bench bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      iic runs with both transports
+ */
+static uint8_t a_bench_handle(const bench_bus_t *bus)
+{
+	uint8_t mode;
+
+	/* link functions */
+	DRIVER_SSD1306_LINK_INIT(&gs_handle, ssd1306_handle_t);
+	DRIVER_SSD1306_LINK_IIC_INIT(&gs_handle, ssd1306_interface_iic_init);
+	DRIVER_SSD1306_LINK_IIC_DEINIT(&gs_handle,
+				       ssd1306_interface_iic_deinit);
+	DRIVER_SSD1306_LINK_IIC_WRITE(&gs_handle, ssd1306_interface_iic_write);
+	DRIVER_SSD1306_LINK_IIC_WRITE_HEADROOM(
+		&gs_handle, ssd1306_interface_iic_write_headroom);
+	DRIVER_SSD1306_LINK_SPI_INIT(&gs_handle, ssd1306_interface_spi_init);
+	DRIVER_SSD1306_LINK_SPI_DEINIT(&gs_handle,
+				       ssd1306_interface_spi_deinit);
+	DRIVER_SSD1306_LINK_SPI_WRITE_COMMAND(&gs_handle,
+					      ssd1306_interface_spi_write_cmd);
+	DRIVER_SSD1306_LINK_SPI_WRITE_BATCH(&gs_handle,
+					    ssd1306_interface_spi_write_batch);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_INIT(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_init);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_DEINIT(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_deinit);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_WRITE(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_write);
+	DRIVER_SSD1306_LINK_RESET_GPIO_INIT(&gs_handle,
+					    ssd1306_interface_reset_gpio_init);
+	DRIVER_SSD1306_LINK_RESET_GPIO_DEINIT(
+		&gs_handle, ssd1306_interface_reset_gpio_deinit);
+	DRIVER_SSD1306_LINK_RESET_GPIO_WRITE(
+		&gs_handle, ssd1306_interface_reset_gpio_write);
+	DRIVER_SSD1306_LINK_DELAY_MS(&gs_handle, ssd1306_interface_delay_ms);
+	DRIVER_SSD1306_LINK_DEBUG_PRINT(&gs_handle,
+					ssd1306_interface_debug_print);
+
+	/* init */
+	sim_reset();
+	sim_set_spi_3wire(bus->spi_3wire);
+	if ((ssd1306_set_interface(&gs_handle, bus->interface) != 0) ||
+	    (ssd1306_set_addr_pin(&gs_handle, SSD1306_ADDR_SA0_0) != 0) ||
+	    (ssd1306_init(&gs_handle) != 0)) {
+		fprintf(stderr, "bench: %s init failed.\n", bus->name);
+
+		return 1;
+	}
+	if (ssd1306_set_memory_addressing_mode(
+		    &gs_handle, SSD1306_MEMORY_ADDRESSING_MODE_PAGE) != 0) {
+		(void)ssd1306_deinit(&gs_handle);
+
+		return 1;
+	}
+
+	/* every flush mode */
+	for (mode = 0; mode < 3; mode++) {
+		if (bus->interface == SSD1306_INTERFACE_IIC) {
+			if ((ssd1306_set_iic_transport(
+				     &gs_handle,
+				     SSD1306_IIC_TRANSPORT_SEPARATE) != 0) ||
+			    (a_bench_flush(bus, "separate",
+					   (ssd1306_flush_mode_t)mode) != 0) ||
+			    (ssd1306_set_iic_transport(
+				     &gs_handle,
+				     SSD1306_IIC_TRANSPORT_CONTINUATION) != 0) ||
+			    (a_bench_flush(bus, "continuation",
+					   (ssd1306_flush_mode_t)mode) != 0)) {
+				(void)ssd1306_deinit(&gs_handle);
+
+				return 1;
+			}
+		} else {
+			if (a_bench_flush(bus, "none",
+					  (ssd1306_flush_mode_t)mode) != 0) {
+				(void)ssd1306_deinit(&gs_handle);
+
+				return 1;
+			}
+		}
+	}
+
+	return ssd1306_deinit(&gs_handle);
+}
+
+/**
+ * @brief     compare the results with a baseline
+ * @param[in] *path points to a baseline csv file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 a scenario regressed or the baseline is invalid
+ * @note      a scenario regresses if it needs more transactions or more wire bytes,
+ *            scenarios missing in the baseline are skipped
+ */
+static uint8_t a_bench_compare(const char *path)
+{
+	FILE *fp;
+	char line[256];
+	char interface[8];
+	char transport[16];
+	char flush[8];
+	char scenario[24];
+	unsigned int transaction;
+	unsigned int payload;
+	unsigned int overhead;
+	unsigned int gpio;
+	uint32_t byte;
+	uint16_t i;
+	uint8_t res;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		fprintf(stderr, "bench: open %s failed.\n", path);
+
+		return 1;
+	}
+	res = 0;
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (sscanf(line, "%7[^,],%15[^,],%7[^,],%23[^,],%u,%u,%u,%u",
+			   interface, transport, flush, scenario, &transaction,
+			   &payload, &overhead, &gpio) != 8) {
+			/* the header */
+			continue;
+		}
+		for (i = 0; i < gs_result_num; i++) {
+			if ((strcmp(gs_result[i].interface, interface) == 0) &&
+			    (strcmp(gs_result[i].transport, transport) == 0) &&
+			    (strcmp(gs_result[i].flush, flush) == 0) &&
+			    (strcmp(gs_result[i].scenario, scenario) == 0)) {
+				break;
+			}
+		}
+		if (i == gs_result_num) {
+			continue;
+		}
+		byte = payload + overhead;
+		if ((gs_result[i].counter.transaction > transaction) ||
+		    (gs_result[i].counter.byte > byte)) {
+			fprintf(stderr,
+				"bench: %s %s %s %s regressed from %u transactions %u bytes to %u transactions %u bytes.\n",
+				interface, transport, flush, scenario,
+				transaction, byte,
+				gs_result[i].counter.transaction,
+				gs_result[i].counter.byte);
+			res = 1;
+		}
+	}
+	fclose(fp);
+
+	return res;
+}
+
+/**
+ * @brief     bench full function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t bench(uint8_t argc, char **argv)
+{
+	int c;
+	int longindex = 0;
+	const char short_options[] = "h";
+	const struct option long_options[] = {
+		{ "help", no_argument, NULL, 'h' },
+		{ "baseline", required_argument, NULL, 1 },
+		{ NULL, 0, NULL, 0 },
+	};
+	char baseline[257] = "";
+	uint16_t i;
+	uint8_t j;
+
+	/* init 0 */
+	optind = 0;
+
+	/* parse */
+	do {
+		/* parse the args */
+		c = getopt_long(argc, argv, short_options, long_options,
+				&longindex);
+
+		/* judge the result */
+		switch (c) {
+		/* help */
+		case 'h': {
+			printf("Usage:\n");
+			printf("  ssd1306_bench [--baseline=<file>]\n");
+			printf("  ssd1306_bench (-h | --help)\n");
+			printf("\n");
+			printf("Options:\n");
+			printf("      --baseline=<file>   Fail if a scenario needs more transactions or bytes than the csv file.\n");
+			printf("  -h, --help              Show the help.\n");
+
+			return 0;
+		}
+
+		/* baseline */
+		case 1: {
+			memset(baseline, 0, sizeof(char) * 257);
+			snprintf(baseline, 256, "%s", optarg);
+
+			break;
+		}
+
+		/* the end */
+		case -1: {
+			break;
+		}
+
+		/* others */
+		default: {
+			return 5;
+		}
+		}
+	} while (c != -1);
+
+	/* a diagonal stripe picture */
+	for (i = 0; i < 32 * 32; i++) {
+		gs_img[i] = (((i / 32) + (i % 32)) % 4 == 0) ? 1 : 0;
+	}
+
+	/* run all buses */
+	printf("interface,transport,flush,scenario,transactions,payload_bytes,overhead_bytes,gpio_writes,clock_hz,time_us\n");
+	for (j = 0; j < sizeof(gs_bus) / sizeof(gs_bus[0]); j++) {
+		if ((a_bench_basic(&gs_bus[j]) != 0) ||
+		    (a_bench_handle(&gs_bus[j]) != 0)) {
+			return 1;
+		}
+	}
+
+	/* gate the regressions */
+	if (baseline[0] != '\0') {
+		return a_bench_compare(baseline);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+	uint8_t res;
+
+	res = bench(argc, argv);
+	if (res == 1) {
+		fprintf(stderr, "bench: run failed.\n");
+	} else if (res == 5) {
+		fprintf(stderr, "bench: param is invalid.\n");
+	}
+
+	return res;
+}
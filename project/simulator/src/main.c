@@ -0,0 +1,652 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ssd1306_display_test.h"
+#include "driver_ssd1306_flush_test.h"
+#include "driver_ssd1306_render_test.h"
+#include "driver_ssd1306_interface.h"
+#include "sim.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+/**
+ * @brief global var definition
+ */
+static ssd1306_handle_t gs_handle; /**< ssd1306 handle */
+
+/**
+ * @brief     compare the virtual gram with the driver gram
+ * @param[in] *name points to a step name
+ * @return    status code
+ *            - 0 success
+ *            - 1 compare failed
+ * @note      none
+ */
+static uint8_t a_sim_compare(const char *name)
+{
+	const sim_state_t *state;
+	sim_counter_t counter;
+	uint8_t x;
+	uint8_t y;
+	uint8_t data;
+
+	state = sim_get_state();
+	for (x = 0; x < 128; x++) {
+		for (y = 0; y < 64; y++) {
+			(void)ssd1306_read_point(&gs_handle, x, y, &data);
+			if (((state->ram[y / 8][x] >> (y % 8)) & 0x01) != data) {
+				ssd1306_interface_debug_print(
+					"sim: %s differs at x %d y %d.\n", name,
+					x, y);
+
+				return 1;
+			}
+		}
+	}
+	sim_get_counter(&counter);
+	if (counter.error != 0) {
+		ssd1306_interface_debug_print(
+			"sim: %s has %d protocol errors.\n", name,
+			(int)counter.error);
+
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  swap the double buffer
+ * @return status code
+ *         - 0 success
+ *         - 1 swap failed
+ * @note   every bus write is wrapped in two swaps, so the front buffer holds the
+ *         drawn frame while it is sent and the frame goes back to the back
+ *         buffer that ssd1306_read_point compares
+ */
+static uint8_t a_sim_swap(void)
+{
+#if (SSD1306_DOUBLE_BUFFER == 1)
+	if (ssd1306_swap_buffers(&gs_handle) != 0) {
+		ssd1306_interface_debug_print("sim: swap buffers failed.\n");
+
+		return 1;
+	}
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief     check the addressing modes of the virtual controller
+ * @param[in] mode is the addressing mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      six bytes go to a 2 x 2 window, so the pointer wraps once
+ */
+static uint8_t a_sim_check_window(ssd1306_memory_addressing_mode_t mode)
+{
+	const sim_state_t *state;
+	uint8_t buf[6] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+	uint8_t expect[4];
+
+	if ((ssd1306_set_memory_addressing_mode(&gs_handle, mode) != 0) ||
+	    (ssd1306_set_column_address_range(&gs_handle, 10, 11) != 0) ||
+	    (ssd1306_set_page_address_range(&gs_handle, 2, 3) != 0) ||
+	    (ssd1306_write_data(&gs_handle, buf, 6) != 0)) {
+		ssd1306_interface_debug_print("sim: write window failed.\n");
+
+		return 1;
+	}
+	if (mode == SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL) {
+		/* page 2 col 10, page 2 col 11, page 3 col 10, page 3 col 11 */
+		expect[0] = 0x55;
+		expect[1] = 0x66;
+		expect[2] = 0x33;
+		expect[3] = 0x44;
+	} else {
+		/* page 2 col 10, page 3 col 10, page 2 col 11, page 3 col 11 */
+		expect[0] = 0x55;
+		expect[2] = 0x66;
+		expect[1] = 0x33;
+		expect[3] = 0x44;
+	}
+	state = sim_get_state();
+	if ((state->ram[2][10] != expect[0]) ||
+	    (state->ram[2][11] != expect[1]) ||
+	    (state->ram[3][10] != expect[2]) ||
+	    (state->ram[3][11] != expect[3])) {
+		ssd1306_interface_debug_print(
+			"sim: addressing mode %d window is wrong.\n", mode);
+
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     run one flush mode against the virtual controller
+ * @param[in] mode is the flush mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_sim_check_flush(ssd1306_flush_mode_t mode)
+{
+	ssd1306_point_t point[64];
+	uint16_t i;
+
+	if (ssd1306_set_flush_mode(&gs_handle, mode) != 0) {
+		ssd1306_interface_debug_print("sim: set flush mode failed.\n");
+
+		return 1;
+	}
+	srand(1 + mode);
+
+	/* full update */
+	for (i = 0; i < 3000; i++) {
+		(void)ssd1306_gram_write_point(&gs_handle, rand() % 128,
+					       rand() % 64, rand() & 0x01);
+	}
+	if ((a_sim_swap() != 0) || (ssd1306_gram_update(&gs_handle) != 0) ||
+	    (a_sim_swap() != 0)) {
+		ssd1306_interface_debug_print("sim: gram update failed.\n");
+
+		return 1;
+	}
+	if (a_sim_compare("update") != 0) {
+		return 1;
+	}
+
+	/* dirty update */
+	(void)ssd1306_gram_write_string(&gs_handle, 3, 5, "12:34", 5, 1,
+					SSD1306_FONT_16);
+	(void)ssd1306_gram_fill_rect(&gs_handle, 10, 40, 90, 60, 1);
+	if ((a_sim_swap() != 0) || (ssd1306_gram_update_dirty(&gs_handle) != 0) ||
+	    (a_sim_swap() != 0)) {
+		ssd1306_interface_debug_print(
+			"sim: gram update dirty failed.\n");
+
+		return 1;
+	}
+	if (a_sim_compare("dirty update") != 0) {
+		return 1;
+	}
+
+	/* diff update */
+	(void)ssd1306_gram_write_string(&gs_handle, 3, 5, "12:35", 5, 0,
+					SSD1306_FONT_16);
+	(void)ssd1306_gram_draw_circle(&gs_handle, 64, 32, 20, 1);
+	if ((a_sim_swap() != 0) || (ssd1306_gram_update_diff(&gs_handle) != 0) ||
+	    (a_sim_swap() != 0)) {
+		ssd1306_interface_debug_print("sim: gram update diff failed.\n");
+
+		return 1;
+	}
+	if (a_sim_compare("diff update") != 0) {
+		return 1;
+	}
+
+	/* immediate points */
+	if (a_sim_swap() != 0) {
+		return 1;
+	}
+	for (i = 0; i < 200; i++) {
+		(void)ssd1306_write_point(&gs_handle, rand() % 128, rand() % 64,
+					  rand() & 0x01);
+	}
+	for (i = 0; i < 64; i++) {
+		point[i].x = (int16_t)(rand() % 128);
+		point[i].y = (int16_t)(rand() % 64);
+	}
+	if ((ssd1306_write_points(&gs_handle, point, 64, 1) != 0) ||
+	    (a_sim_swap() != 0)) {
+		ssd1306_interface_debug_print("sim: write points failed.\n");
+
+		return 1;
+	}
+	if (a_sim_compare("write points") != 0) {
+		return 1;
+	}
+
+	/* clear */
+	if (ssd1306_clear(&gs_handle) != 0) {
+		ssd1306_interface_debug_print("sim: clear failed.\n");
+
+		return 1;
+	}
+	if (a_sim_compare("clear") != 0) {
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief     check the driver against the virtual controller
+ * @param[in] interface is the interface type
+ * @param[in] addr is the iic device address
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_sim_check(ssd1306_interface_t interface,
+			   ssd1306_address_t addr)
+{
+	static uint8_t pixel[64][128];
+	const sim_state_t *state;
+	uint8_t mode;
+
+	/* link functions */
+	DRIVER_SSD1306_LINK_INIT(&gs_handle, ssd1306_handle_t);
+	DRIVER_SSD1306_LINK_IIC_INIT(&gs_handle, ssd1306_interface_iic_init);
+	DRIVER_SSD1306_LINK_IIC_DEINIT(&gs_handle,
+				       ssd1306_interface_iic_deinit);
+	DRIVER_SSD1306_LINK_IIC_WRITE(&gs_handle, ssd1306_interface_iic_write);
+	DRIVER_SSD1306_LINK_IIC_WRITE_HEADROOM(
+		&gs_handle, ssd1306_interface_iic_write_headroom);
+	DRIVER_SSD1306_LINK_SPI_INIT(&gs_handle, ssd1306_interface_spi_init);
+	DRIVER_SSD1306_LINK_SPI_DEINIT(&gs_handle,
+				       ssd1306_interface_spi_deinit);
+	DRIVER_SSD1306_LINK_SPI_WRITE_COMMAND(&gs_handle,
+					      ssd1306_interface_spi_write_cmd);
+	DRIVER_SSD1306_LINK_SPI_WRITE_BATCH(&gs_handle,
+					    ssd1306_interface_spi_write_batch);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_INIT(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_init);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_DEINIT(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_deinit);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_WRITE(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_write);
+	DRIVER_SSD1306_LINK_RESET_GPIO_INIT(&gs_handle,
+					    ssd1306_interface_reset_gpio_init);
+	DRIVER_SSD1306_LINK_RESET_GPIO_DEINIT(
+		&gs_handle, ssd1306_interface_reset_gpio_deinit);
+	DRIVER_SSD1306_LINK_RESET_GPIO_WRITE(
+		&gs_handle, ssd1306_interface_reset_gpio_write);
+	DRIVER_SSD1306_LINK_DELAY_MS(&gs_handle, ssd1306_interface_delay_ms);
+	DRIVER_SSD1306_LINK_DEBUG_PRINT(&gs_handle,
+					ssd1306_interface_debug_print);
+#if ((SSD1306_STATS == 1) || (SSD1306_TRACE_SIZE > 0))
+	DRIVER_SSD1306_LINK_TIMESTAMP_US(&gs_handle,
+					 ssd1306_interface_timestamp_us);
+#endif
+#if (SSD1306_ASYNC_FLUSH == 1)
+	DRIVER_SSD1306_LINK_ASYNC_WRITE(&gs_handle,
+					ssd1306_interface_async_write);
+	DRIVER_SSD1306_LINK_ASYNC_POLL(&gs_handle,
+				       ssd1306_interface_async_poll);
+#endif
+
+	/* init */
+	if ((ssd1306_set_interface(&gs_handle, interface) != 0) ||
+	    (ssd1306_set_addr_pin(&gs_handle, addr) != 0) ||
+	    (ssd1306_init(&gs_handle) != 0)) {
+		ssd1306_interface_debug_print("sim: init failed.\n");
+
+		return 1;
+	}
+	ssd1306_interface_debug_print("sim: start sim check.\n");
+	sim_clear_counter();
+
+	/* configure the panel like the tests */
+	if ((ssd1306_set_multiplex_ratio(&gs_handle, 0x3F) != 0) ||
+	    (ssd1306_set_display_offset(&gs_handle, 0x00) != 0) ||
+	    (ssd1306_set_display_start_line(&gs_handle, 0x00) != 0) ||
+	    (ssd1306_set_charge_pump(&gs_handle,
+				     SSD1306_CHARGE_PUMP_ENABLE) != 0) ||
+	    (ssd1306_set_segment_remap(
+		     &gs_handle, SSD1306_SEGMENT_COLUMN_ADDRESS_127) != 0) ||
+	    (ssd1306_set_scan_direction(
+		     &gs_handle, SSD1306_SCAN_DIRECTION_COMN_1_START) != 0) ||
+	    (ssd1306_set_contrast(&gs_handle, 0xCF) != 0) ||
+	    (ssd1306_set_display_mode(&gs_handle,
+				      SSD1306_DISPLAY_MODE_NORMAL) != 0) ||
+	    (ssd1306_set_display(&gs_handle, SSD1306_DISPLAY_ON) != 0)) {
+		ssd1306_interface_debug_print("sim: configure failed.\n");
+		(void)ssd1306_deinit(&gs_handle);
+
+		return 1;
+	}
+	state = sim_get_state();
+	if ((state->multiplex != 0x3F) || (state->contrast != 0xCF) ||
+	    (state->segment_remap != 1) || (state->scan_remap != 1) ||
+	    (state->charge_pump != 0x14) || (state->display_on != 1) ||
+	    (state->inverse != 0)) {
+		ssd1306_interface_debug_print(
+			"sim: the decoded registers are wrong.\n");
+		(void)ssd1306_deinit(&gs_handle);
+
+		return 1;
+	}
+
+	/* addressing modes */
+	if ((a_sim_check_window(SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL) !=
+	     0) ||
+	    (a_sim_check_window(SSD1306_MEMORY_ADDRESSING_MODE_VERTICAL) !=
+	     0) ||
+	    (ssd1306_set_memory_addressing_mode(
+		     &gs_handle, SSD1306_MEMORY_ADDRESSING_MODE_PAGE) != 0)) {
+		(void)ssd1306_deinit(&gs_handle);
+
+		return 1;
+	}
+
+	/* flush modes */
+	for (mode = 0; mode < 3; mode++) {
+		if (a_sim_check_flush((ssd1306_flush_mode_t)mode) != 0) {
+			(void)ssd1306_deinit(&gs_handle);
+
+			return 1;
+		}
+		ssd1306_interface_debug_print(
+			"sim: flush mode %d matches the virtual gram.\n", mode);
+	}
+	if (interface == SSD1306_INTERFACE_IIC) {
+		(void)ssd1306_set_iic_transport(
+			&gs_handle, SSD1306_IIC_TRANSPORT_CONTINUATION);
+		for (mode = 0; mode < 3; mode++) {
+			if (a_sim_check_flush((ssd1306_flush_mode_t)mode) != 0) {
+				(void)ssd1306_deinit(&gs_handle);
+
+				return 1;
+			}
+		}
+		ssd1306_interface_debug_print(
+			"sim: continuation transport matches the virtual gram.\n");
+	}
+
+	/* the remapped panel shows gram (0, 0) at the top left */
+	(void)ssd1306_gram_write_point(&gs_handle, 0, 0, 1);
+	(void)a_sim_swap();
+	(void)ssd1306_gram_update(&gs_handle);
+	sim_render(pixel);
+	if ((pixel[0][0] != 1) || (pixel[63][127] != 0)) {
+		ssd1306_interface_debug_print(
+			"sim: the rendered panel is wrong.\n");
+		(void)ssd1306_deinit(&gs_handle);
+
+		return 1;
+	}
+
+	ssd1306_interface_debug_print("sim: finish sim check.\n");
+	(void)ssd1306_deinit(&gs_handle);
+
+	return 0;
+}
+
+/**
+ * @brief     ssd1306 full function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t ssd1306(uint8_t argc, char **argv)
+{
+	int c;
+	int longindex = 0;
+	const char short_options[] = "hit:";
+	const struct option long_options[] = {
+		{ "help", no_argument, NULL, 'h' },
+		{ "information", no_argument, NULL, 'i' },
+		{ "test", required_argument, NULL, 't' },
+		{ "addr", required_argument, NULL, 1 },
+		{ "interface", required_argument, NULL, 2 },
+		{ "dump", required_argument, NULL, 3 },
+		{ NULL, 0, NULL, 0 },
+	};
+	char type[33] = "unknown";
+	char dump[257] = "";
+	ssd1306_address_t addr = SSD1306_ADDR_SA0_0;
+	ssd1306_interface_t interface = SSD1306_INTERFACE_IIC;
+	uint8_t res;
+
+	/* if no params */
+	if (argc == 1) {
+		/* goto the help */
+		goto help;
+	}
+
+	/* init 0 */
+	optind = 0;
+
+	/* parse */
+	do {
+		/* parse the args */
+		c = getopt_long(argc, argv, short_options, long_options,
+				&longindex);
+
+		/* judge the result */
+		switch (c) {
+		/* help */
+		case 'h': {
+			/* set the type */
+			memset(type, 0, sizeof(char) * 33);
+			snprintf(type, 32, "h");
+
+			break;
+		}
+
+		/* information */
+		case 'i': {
+			/* set the type */
+			memset(type, 0, sizeof(char) * 33);
+			snprintf(type, 32, "i");
+
+			break;
+		}
+
+		/* test */
+		case 't': {
+			/* set the type */
+			memset(type, 0, sizeof(char) * 33);
+			snprintf(type, 32, "t_%s", optarg);
+
+			break;
+		}
+
+		/* addr */
+		case 1: {
+			/* set the addr pin */
+			if (strcmp("0", optarg) == 0) {
+				addr = SSD1306_ADDR_SA0_0;
+			} else if (strcmp("1", optarg) == 0) {
+				addr = SSD1306_ADDR_SA0_1;
+			} else {
+				return 5;
+			}
+
+			break;
+		}
+
+		/* interface */
+		case 2: {
+			/* set the interface */
+			if (strcmp("iic", optarg) == 0) {
+				interface = SSD1306_INTERFACE_IIC;
+				sim_set_spi_3wire(0);
+			} else if (strcmp("spi", optarg) == 0) {
+				interface = SSD1306_INTERFACE_SPI;
+				sim_set_spi_3wire(0);
+#if (SSD1306_SPI_3WIRE == 1)
+			} else if (strcmp("spi3", optarg) == 0) {
+				interface = SSD1306_INTERFACE_SPI_3WIRE;
+				sim_set_spi_3wire(1);
+#endif
+			} else {
+				return 5;
+			}
+
+			break;
+		}
+
+		/* dump */
+		case 3: {
+			/* set the dump path */
+			memset(dump, 0, sizeof(char) * 257);
+			strncpy(dump, optarg, 256);
+
+			break;
+		}
+
+		/* the end */
+		case -1: {
+			break;
+		}
+
+		/* others */
+		default: {
+			return 5;
+		}
+		}
+	} while (c != -1);
+
+	/* run the function */
+	if (strcmp("t_sim", type) == 0) {
+		/* run sim check */
+		res = a_sim_check(interface, addr);
+	} else if (strcmp("t_display", type) == 0) {
+		/* run display test */
+		res = ssd1306_display_test(interface, addr);
+	} else if (strcmp("t_flush", type) == 0) {
+		/* run flush test */
+		res = ssd1306_flush_test(interface, addr);
+	} else if (strcmp("t_render", type) == 0) {
+		/* run render test */
+		res = ssd1306_render_test(interface, addr);
+	} else if (strcmp("h", type) == 0) {
+help:
+		ssd1306_interface_debug_print("Usage:\n");
+		ssd1306_interface_debug_print(
+			"  ssd1306 (-i | --information)\n");
+		ssd1306_interface_debug_print("  ssd1306 (-h | --help)\n");
+		ssd1306_interface_debug_print(
+			"  ssd1306 (-t sim | --test=sim) [--addr=<0 | 1>] [--interface=<iic | spi | spi3>] [--dump=<file>]\n");
+		ssd1306_interface_debug_print(
+			"  ssd1306 (-t display | --test=display) [--addr=<0 | 1>] [--interface=<iic | spi | spi3>] [--dump=<file>]\n");
+		ssd1306_interface_debug_print(
+			"  ssd1306 (-t flush | --test=flush) [--addr=<0 | 1>] [--interface=<iic | spi | spi3>] [--dump=<file>]\n");
+		ssd1306_interface_debug_print(
+			"  ssd1306 (-t render | --test=render) [--addr=<0 | 1>] [--interface=<iic | spi | spi3>] [--dump=<file>]\n");
+		ssd1306_interface_debug_print("\n");
+		ssd1306_interface_debug_print("Options:\n");
+		ssd1306_interface_debug_print(
+			"      --addr=<0 | 1>      Set the iic addr pin.([default: 0])\n");
+		ssd1306_interface_debug_print(
+			"      --dump=<file>       Save the virtual panel as a pgm image after the test.\n");
+		ssd1306_interface_debug_print(
+			"  -h, --help              Show the help.\n");
+		ssd1306_interface_debug_print(
+			"  -i, --information       Show the chip information.\n");
+		ssd1306_interface_debug_print(
+			"      --interface=<iic | spi | spi3>\n");
+		ssd1306_interface_debug_print(
+			"                          Set the chip interface, spi3 needs SSD1306_SPI_3WIRE.([default: iic])\n");
+		ssd1306_interface_debug_print(
+			"  -t <sim | display | flush | render>, --test=<sim | display | flush | render>\n");
+		ssd1306_interface_debug_print(
+			"                          Run the driver test on the virtual controller.\n");
+
+		return 0;
+	} else if (strcmp("i", type) == 0) {
+		ssd1306_info_t info;
+
+		/* print ssd1306 info */
+		ssd1306_info(&info);
+		ssd1306_interface_debug_print("ssd1306: chip is %s.\n",
+					      info.chip_name);
+		ssd1306_interface_debug_print("ssd1306: manufacturer is %s.\n",
+					      info.manufacturer_name);
+		ssd1306_interface_debug_print("ssd1306: interface is %s.\n",
+					      info.interface);
+		ssd1306_interface_debug_print(
+			"ssd1306: driver version is %d.%d.\n",
+			info.driver_version / 1000,
+			(info.driver_version % 1000) / 100);
+
+		return 0;
+	} else {
+		return 5;
+	}
+
+	/* save the panel */
+	if ((res == 0) && (dump[0] != '\0')) {
+		if (sim_save_pgm(dump) != 0) {
+			ssd1306_interface_debug_print("sim: dump failed.\n");
+
+			return 1;
+		}
+	}
+
+	return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+	uint8_t res;
+
+	/* power on */
+	sim_reset();
+
+	res = ssd1306(argc, argv);
+	if (res == 0) {
+		/* run success */
+	} else if (res == 1) {
+		ssd1306_interface_debug_print("ssd1306: run failed.\n");
+	} else if (res == 5) {
+		ssd1306_interface_debug_print("ssd1306: param is invalid.\n");
+	} else {
+		ssd1306_interface_debug_print("ssd1306: unknown status code.\n");
+	}
+
+	return res;
+}
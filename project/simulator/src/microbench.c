@@ -0,0 +1,518 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      microbench.c
+ * @brief     microbench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _POSIX_C_SOURCE 199309L /**< clock_gettime and CLOCK_MONOTONIC */
+
+#include "driver_ssd1306_interface.h"
+#include "sim.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief microbench definition
+ */
+#define MICROBENCH_MAX_REPEAT 1000 /**< max measured samples */
+#define MICROBENCH_SAMPLE_NS 200000 /**< min sample time in ns */
+
+/**
+ * @brief microbench case structure definition
+ */
+typedef struct microbench_case_s {
+	const char *name; /**< case name */
+	uint8_t (*run)(uint32_t i); /**< run one operation */
+} microbench_case_t;
+
+/**
+ * @brief global var definition
+ */
+static ssd1306_handle_t gs_handle; /**< ssd1306 handle */
+static uint8_t gs_img[128 * 64]; /**< picture with one byte per pixel */
+static char gs_str[] = "12:34:56"; /**< rendered string */
+static double gs_sample[MICROBENCH_MAX_REPEAT]; /**< ns per op samples */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_microbench_ns(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     write a string with the font 12
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the color toggles so every call changes the gram
+ */
+static uint8_t a_microbench_string_12(uint32_t i)
+{
+	return ssd1306_gram_write_string(&gs_handle, 0, 0, gs_str, 8,
+					 (uint8_t)(i & 1), SSD1306_FONT_12);
+}
+
+/**
+ * @brief     write a string with the font 16
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the color toggles so every call changes the gram
+ */
+static uint8_t a_microbench_string_16(uint32_t i)
+{
+	return ssd1306_gram_write_string(&gs_handle, 0, 0, gs_str, 8,
+					 (uint8_t)(i & 1), SSD1306_FONT_16);
+}
+
+/**
+ * @brief     write a string with the font 24
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the color toggles so every call changes the gram
+ */
+static uint8_t a_microbench_string_24(uint32_t i)
+{
+	return ssd1306_gram_write_string(&gs_handle, 0, 0, gs_str, 8,
+					 (uint8_t)(i & 1), SSD1306_FONT_24);
+}
+
+/**
+ * @brief     fill the whole gram
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_microbench_rect_full(uint32_t i)
+{
+	return ssd1306_gram_fill_rect(&gs_handle, 0, 0, 127, 63,
+				      (uint8_t)(i & 1));
+}
+
+/**
+ * @brief     fill a rect on the page boundaries
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_microbench_rect_aligned(uint32_t i)
+{
+	return ssd1306_gram_fill_rect(&gs_handle, 32, 16, 95, 47,
+				      (uint8_t)(i & 1));
+}
+
+/**
+ * @brief     fill a rect across the page boundaries
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_microbench_rect_unaligned(uint32_t i)
+{
+	return ssd1306_gram_fill_rect(&gs_handle, 33, 13, 94, 50,
+				      (uint8_t)(i & 1));
+}
+
+/**
+ * @brief     fill a small rect across a page boundary
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_microbench_rect_small(uint32_t i)
+{
+	return ssd1306_gram_fill_rect(&gs_handle, 61, 29, 66, 34,
+				      (uint8_t)(i & 1));
+}
+
+/**
+ * @brief     draw a picture over the whole gram
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_microbench_picture_full(uint32_t i)
+{
+	(void)i;
+
+	return ssd1306_gram_draw_picture(&gs_handle, 0, 0, 127, 63, gs_img);
+}
+
+/**
+ * @brief     draw a picture on the page boundaries
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_microbench_picture_aligned(uint32_t i)
+{
+	(void)i;
+
+	return ssd1306_gram_draw_picture(&gs_handle, 48, 16, 79, 47, gs_img);
+}
+
+/**
+ * @brief     draw a picture across the page boundaries
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_microbench_picture_unaligned(uint32_t i)
+{
+	(void)i;
+
+	return ssd1306_gram_draw_picture(&gs_handle, 45, 13, 76, 44, gs_img);
+}
+
+/**
+ * @brief     write a point
+ * @param[in] i is the operation index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the points sweep the whole gram
+ */
+static uint8_t a_microbench_point(uint32_t i)
+{
+	return ssd1306_gram_write_point(&gs_handle, (uint8_t)(i & 0x7F),
+					(uint8_t)((i >> 7) & 0x3F),
+					(uint8_t)((i >> 13) & 1));
+}
+
+/**
+ * @brief microbench cases
+ */
+static const microbench_case_t gs_case[] = {
+	{ "string_font12_8ch", a_microbench_string_12 },
+	{ "string_font16_8ch", a_microbench_string_16 },
+	{ "string_font24_8ch", a_microbench_string_24 },
+	{ "rect_full_128x64", a_microbench_rect_full },
+	{ "rect_aligned_64x32", a_microbench_rect_aligned },
+	{ "rect_unaligned_62x38", a_microbench_rect_unaligned },
+	{ "rect_small_6x6", a_microbench_rect_small },
+	{ "picture_full_128x64", a_microbench_picture_full },
+	{ "picture_aligned_32x32", a_microbench_picture_aligned },
+	{ "picture_unaligned_32x32", a_microbench_picture_unaligned },
+	{ "point", a_microbench_point },
+};
+
+/**
+ * @brief     sort compare function
+ * @param[in] *a points to a sample
+ * @param[in] *b points to a sample
+ * @return    compare result
+ * @note      none
+ */
+static int a_microbench_compare(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ * @brief     run one case
+ * @param[in] *c points to a microbench case structure
+ * @param[in] warmup is the warmup sample number
+ * @param[in] repeat is the measured sample number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the operations per sample are doubled until a sample takes MICROBENCH_SAMPLE_NS
+ */
+static uint8_t a_microbench_run(const microbench_case_t *c, uint32_t warmup,
+				uint32_t repeat)
+{
+	uint64_t start;
+	uint64_t ns;
+	uint32_t ops;
+	uint32_t i;
+	uint32_t j;
+	uint32_t n;
+	double mean;
+	double sd;
+
+	/* calibrate */
+	n = 0;
+	ops = 1;
+	while (1) {
+		start = a_microbench_ns();
+		for (j = 0; j < ops; j++) {
+			if (c->run(n++) != 0) {
+				fprintf(stderr, "microbench: %s failed.\n",
+					c->name);
+
+				return 1;
+			}
+		}
+		ns = a_microbench_ns() - start;
+		if ((ns >= MICROBENCH_SAMPLE_NS) || (ops >= (1U << 24))) {
+			break;
+		}
+		ops *= 2;
+	}
+
+	/* warm up and measure */
+	for (i = 0; i < warmup + repeat; i++) {
+		start = a_microbench_ns();
+		for (j = 0; j < ops; j++) {
+			(void)c->run(n++);
+		}
+		ns = a_microbench_ns() - start;
+		if (i >= warmup) {
+			gs_sample[i - warmup] = (double)ns / (double)ops;
+		}
+	}
+
+	/* statistics */
+	mean = 0.0;
+	for (i = 0; i < repeat; i++) {
+		mean += gs_sample[i];
+	}
+	mean /= (double)repeat;
+	sd = 0.0;
+	for (i = 0; i < repeat; i++) {
+		sd += (gs_sample[i] - mean) * (gs_sample[i] - mean);
+	}
+	sd = (repeat > 1) ? sqrt(sd / (double)(repeat - 1)) : 0.0;
+	qsort(gs_sample, repeat, sizeof(double), a_microbench_compare);
+	printf("%s,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n", c->name, ops, repeat,
+	       gs_sample[0], gs_sample[repeat / 2], mean, sd,
+	       gs_sample[repeat - 1]);
+
+	return 0;
+}
+
+/**
+ * @brief     microbench full function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+uint8_t microbench(uint8_t argc, char **argv)
+{
+	int c;
+	int longindex = 0;
+	const char short_options[] = "h";
+	const struct option long_options[] = {
+		{ "help", no_argument, NULL, 'h' },
+		{ "warmup", required_argument, NULL, 1 },
+		{ "repeat", required_argument, NULL, 2 },
+		{ "filter", required_argument, NULL, 3 },
+		{ NULL, 0, NULL, 0 },
+	};
+	char filter[33] = "";
+	uint32_t warmup = 5;
+	uint32_t repeat = 31;
+	uint32_t i;
+
+	/* init 0 */
+	optind = 0;
+
+	/* parse */
+	do {
+		/* parse the args */
+		c = getopt_long(argc, argv, short_options, long_options,
+				&longindex);
+
+		/* judge the result */
+		switch (c) {
+		/* help */
+		case 'h': {
+			printf("Usage:\n");
+			printf("  ssd1306_microbench [--warmup=<n>] [--repeat=<n>] [--filter=<name>]\n");
+			printf("  ssd1306_microbench (-h | --help)\n");
+			printf("\n");
+			printf("Options:\n");
+			printf("      --filter=<name>     Run the cases whose name contains the text.\n");
+			printf("  -h, --help              Show the help.\n");
+			printf("      --repeat=<n>        Set the measured samples.([default: 31])\n");
+			printf("      --warmup=<n>        Set the discarded warmup samples.([default: 5])\n");
+
+			return 0;
+		}
+
+		/* warmup */
+		case 1: {
+			warmup = (uint32_t)atol(optarg);
+
+			break;
+		}
+
+		/* repeat */
+		case 2: {
+			repeat = (uint32_t)atol(optarg);
+			if ((repeat == 0) || (repeat > MICROBENCH_MAX_REPEAT)) {
+				return 5;
+			}
+
+			break;
+		}
+
+		/* filter */
+		case 3: {
+			memset(filter, 0, sizeof(char) * 33);
+			snprintf(filter, 32, "%s", optarg);
+
+			break;
+		}
+
+		/* the end */
+		case -1: {
+			break;
+		}
+
+		/* others */
+		default: {
+			return 5;
+		}
+		}
+	} while (c != -1);
+
+	/* link functions */
+	DRIVER_SSD1306_LINK_INIT(&gs_handle, ssd1306_handle_t);
+	DRIVER_SSD1306_LINK_IIC_INIT(&gs_handle, ssd1306_interface_iic_init);
+	DRIVER_SSD1306_LINK_IIC_DEINIT(&gs_handle,
+				       ssd1306_interface_iic_deinit);
+	DRIVER_SSD1306_LINK_IIC_WRITE(&gs_handle, ssd1306_interface_iic_write);
+	DRIVER_SSD1306_LINK_IIC_WRITE_HEADROOM(
+		&gs_handle, ssd1306_interface_iic_write_headroom);
+	DRIVER_SSD1306_LINK_SPI_INIT(&gs_handle, ssd1306_interface_spi_init);
+	DRIVER_SSD1306_LINK_SPI_DEINIT(&gs_handle,
+				       ssd1306_interface_spi_deinit);
+	DRIVER_SSD1306_LINK_SPI_WRITE_COMMAND(&gs_handle,
+					      ssd1306_interface_spi_write_cmd);
+	DRIVER_SSD1306_LINK_SPI_WRITE_BATCH(&gs_handle,
+					    ssd1306_interface_spi_write_batch);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_INIT(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_init);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_DEINIT(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_deinit);
+	DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_WRITE(
+		&gs_handle, ssd1306_interface_spi_cmd_data_gpio_write);
+	DRIVER_SSD1306_LINK_RESET_GPIO_INIT(&gs_handle,
+					    ssd1306_interface_reset_gpio_init);
+	DRIVER_SSD1306_LINK_RESET_GPIO_DEINIT(
+		&gs_handle, ssd1306_interface_reset_gpio_deinit);
+	DRIVER_SSD1306_LINK_RESET_GPIO_WRITE(
+		&gs_handle, ssd1306_interface_reset_gpio_write);
+	DRIVER_SSD1306_LINK_DELAY_MS(&gs_handle, ssd1306_interface_delay_ms);
+	DRIVER_SSD1306_LINK_DEBUG_PRINT(&gs_handle,
+					ssd1306_interface_debug_print);
+
+	/* init, the gram functions never touch the bus */
+	sim_reset();
+	if ((ssd1306_set_interface(&gs_handle, SSD1306_INTERFACE_IIC) != 0) ||
+	    (ssd1306_set_addr_pin(&gs_handle, SSD1306_ADDR_SA0_0) != 0) ||
+	    (ssd1306_init(&gs_handle) != 0)) {
+		fprintf(stderr, "microbench: init failed.\n");
+
+		return 1;
+	}
+
+	/* a diagonal stripe picture */
+	for (i = 0; i < 128 * 64; i++) {
+		gs_img[i] = (((i / 64) + (i % 64)) % 4 == 0) ? 1 : 0;
+	}
+
+	/* run all cases */
+	printf("case,ops_per_sample,samples,min_ns,median_ns,mean_ns,stddev_ns,max_ns\n");
+	for (i = 0; i < sizeof(gs_case) / sizeof(gs_case[0]); i++) {
+		if ((filter[0] != '\0') &&
+		    (strstr(gs_case[i].name, filter) == NULL)) {
+			continue;
+		}
+		if (a_microbench_run(&gs_case[i], warmup, repeat) != 0) {
+			(void)ssd1306_deinit(&gs_handle);
+
+			return 1;
+		}
+	}
+
+	return ssd1306_deinit(&gs_handle);
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc is arg numbers
+ * @param[in] **argv is the arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+	uint8_t res;
+
+	res = microbench(argc, argv);
+	if (res == 1) {
+		fprintf(stderr, "microbench: run failed.\n");
+	} else if (res == 5) {
+		fprintf(stderr, "microbench: param is invalid.\n");
+	}
+
+	return res;
+}
@@ -83,6 +83,21 @@ uint8_t ssd1306_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus write with headroom
+ * @param[in] addr is the iic device write address
+ * @param[in] *buf points to a data buffer starting with the control byte
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ssd1306_interface_iic_write_headroom(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_write_cmd(addr, buf, len);
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -121,6 +136,69 @@ uint8_t ssd1306_interface_spi_write_cmd(uint8_t *buf, uint16_t len)
     return spi_write_cmd(buf, len);
 }
 
+/**
+ * @brief     interface spi bus write batch
+ * @param[in] **buf points to the segment buffers
+ * @param[in] *len points to the segment lengths
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      each segment is one spi transfer
+ */
+uint8_t ssd1306_interface_spi_write_batch(uint8_t **buf, uint16_t *len, uint8_t num)
+{
+    uint8_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        if (spi_write_cmd(buf[i], len[i]) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface bus set speed
+ * @param[in] interface is the interface in use
+ * @param[in] hz is the bus clock in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      optional, the iic clock is fixed by iic_init
+ */
+uint8_t ssd1306_interface_bus_set_speed(uint8_t interface, uint32_t hz)
+{
+    if (interface == SSD1306_INTERFACE_IIC)
+    {
+        return 1;
+    }
+    
+    return spi_set_speed(hz);
+}
+
+/**
+ * @brief  interface get the monotonic time
+ * @return time in us
+ * @note   it is the hal tick with the systick count inside the tick
+ */
+uint32_t ssd1306_interface_timestamp_us(void)
+{
+    uint32_t ms;
+    uint32_t val;
+    
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+    
+    return ms * 1000 + ((SysTick->LOAD - val) * 1000) / (SysTick->LOAD + 1);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms
@@ -79,6 +79,16 @@ uint8_t spi_init(spi_mode_t mode);
  */
 uint8_t spi_deinit(void);
 
+/**
+ * @brief     spi bus set speed
+ * @param[in] freq is the spi running frequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the fastest pclk2 prescaler not above freq is used
+ */
+uint8_t spi_set_speed(uint32_t freq);
+
 /**
  * @brief     spi bus write command
  * @param[in] *buf points to a data buffer
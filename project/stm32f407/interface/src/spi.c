@@ -137,6 +137,42 @@ uint8_t spi_deinit(void)
     return 0;
 }
 
+/**
+ * @brief     spi bus set speed
+ * @param[in] freq is the spi running frequence
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      the fastest pclk2 prescaler not above freq is used
+ */
+uint8_t spi_set_speed(uint32_t freq)
+{
+    uint32_t pclk;
+    uint32_t i;
+    
+    /* find the prescaler */
+    pclk = HAL_RCC_GetPCLK2Freq();
+    for (i = 0; i < 8; i++)
+    {
+        if ((pclk >> (i + 1)) <= freq)
+        {
+            break;
+        }
+    }
+    if (i == 8)
+    {
+        return 1;
+    }
+    
+    /* set the prescaler */
+    __HAL_SPI_DISABLE(&g_spi_handle);
+    g_spi_handle.Init.BaudRatePrescaler = i << SPI_CR1_BR_Pos;
+    MODIFY_REG(g_spi_handle.Instance->CR1, SPI_CR1_BR, g_spi_handle.Init.BaudRatePrescaler);
+    __HAL_SPI_ENABLE(&g_spi_handle);
+    
+    return 0;
+}
+
 /**
  * @brief     spi bus write command
  * @param[in] *buf points to a data buffer
@@ -37,6 +37,8 @@
 #include "driver_ssd1306_basic.h"
 #include "driver_ssd1306_advance.h"
 #include "driver_ssd1306_display_test.h"
+#include "driver_ssd1306_flush_test.h"
+#include "driver_ssd1306_render_test.h"
 #include "clock.h"
 #include "delay.h"
 #include "uart.h"
@@ -446,6 +448,30 @@ uint8_t ssd1306(uint8_t argc, char** argv)
             return 0;
         }
     }
+    else if (strcmp("t_flush", type) == 0)
+    {
+        /* run flush test */
+        if (ssd1306_flush_test(interface, addr) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("t_render", type) == 0)
+    {
+        /* run render test */
+        if (ssd1306_render_test(interface, addr) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("e_basic-str", type) == 0)
     {
         uint8_t res;
@@ -943,6 +969,8 @@ uint8_t ssd1306(uint8_t argc, char** argv)
         ssd1306_interface_debug_print("  ssd1306 (-h | --help)\n");
         ssd1306_interface_debug_print("  ssd1306 (-p | --port)\n");
         ssd1306_interface_debug_print("  ssd1306 (-t display | --test=display) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
+        ssd1306_interface_debug_print("  ssd1306 (-t flush | --test=flush) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
+        ssd1306_interface_debug_print("  ssd1306 (-t render | --test=render) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
         ssd1306_interface_debug_print("  ssd1306 (-e basic-init | --example=basic-init) [--addr=<0 | 1>] [--interface=<iic | spi>]\n");
         ssd1306_interface_debug_print("  ssd1306 (-e basic-deinit | --example=basic-deinit)\n");
         ssd1306_interface_debug_print("  ssd1306 (-e basic-str | --example=basic-str) [--str=<string>]\n");
@@ -991,7 +1019,7 @@ uint8_t ssd1306(uint8_t argc, char** argv)
         ssd1306_interface_debug_print("      --start=<spage>     Set the scrolling start page.([default: 0])\n");
         ssd1306_interface_debug_print("      --stop=<epage>      Set the scrolling stop page.([default: 7])\n");
         ssd1306_interface_debug_print("      --str=<string>      Set the display string.([default: libdriver])\n");
-        ssd1306_interface_debug_print("  -t <display>, --test=<display>\n");
+        ssd1306_interface_debug_print("  -t <display | flush | render>, --test=<display | flush | render>\n");
         ssd1306_interface_debug_print("                          Run the driver test.\n");
         ssd1306_interface_debug_print("      --x0=<x0>           Set the x0 and it is the x of the point.\n");
         ssd1306_interface_debug_print("      --x1=<x1>           Set the x1 and it is the top left x of the rect.\n");
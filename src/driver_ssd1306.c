@@ -110,1010 +110,4561 @@
 #define SSD1306_CMD_NOP		       0xE3 /**< command nop */
 
 /**
- * @brief     write one byte
+ * @brief diff cost definition, in unchanged bytes a new run is worth
+ */
+#define SSD1306_DIFF_IIC_RUN_COST \
+	7 /**< separate iic, 3 commands and 2 address and control byte pairs */
+#define SSD1306_DIFF_IIC_CONTINUATION_RUN_COST \
+	8 /**< continuation iic, address, 3 co and command pairs and 0x40 */
+#define SSD1306_DIFF_IIC_BYTE_RUN_COST \
+	3 /**< byte flush on iic, 3 command transactions for 1 data transaction */
+#define SSD1306_DIFF_SPI_RUN_COST \
+	3 /**< 4-wire spi, 3 commands, the 2 gpio writes are not counted */
+#define SSD1306_DIFF_SPI_3WIRE_RUN_COST \
+	3 /**< 3-wire spi, 3 command words, the frame padding is below a word */
+
+/**
+ * @brief iic continuation message definition
+ */
+#define SSD1306_IIC_MIXED_CMD_MAX  8 /**< max commands in one message */
+#define SSD1306_IIC_MIXED_DATA_MAX 128 /**< max data bytes in one message */
+
+/**
+ * @brief sine table of 0 to 90 degree in q14
+ */
+static const int16_t gsc_ssd1306_sin[91] = {
+	0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+	2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+	5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+	8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+	10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+	12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+	14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+	15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+	16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+	16384,
+};
+
+/**
+ * @brief gram access definition
+ */
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+#define SSD1306_BUFFER_BYTE(buffer, x, page) \
+	((buffer)[(page)][(x)]) /**< buffer byte of a column and page */
+#define SSD1306_FRAME_ADDRESSING_MODE \
+	SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL /**< frame flush mode */
+#else
+#define SSD1306_BUFFER_BYTE(buffer, x, page) \
+	((buffer)[(x)][(page)]) /**< buffer byte of a column and page */
+#define SSD1306_FRAME_ADDRESSING_MODE \
+	SSD1306_MEMORY_ADDRESSING_MODE_VERTICAL /**< frame flush mode */
+#endif
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+#define SSD1306_BUFFER_VIEW(frame) \
+	((uint8_t(*)[128]) & (frame)[1]) /**< gram view after the headroom */
+#else
+#define SSD1306_BUFFER_VIEW(frame) \
+	((uint8_t(*)[8]) & (frame)[1]) /**< gram view after the headroom */
+#endif
+#if (SSD1306_DOUBLE_BUFFER == 1)
+#define SSD1306_GRAM(handle, x, page)                                    \
+	SSD1306_BUFFER_BYTE(                                              \
+		SSD1306_BUFFER_VIEW((handle)->buffer[(handle)->front ^ 1]), \
+		x, page) /**< drawing byte */
+#define SSD1306_FRONT(handle, x, page)                               \
+	SSD1306_BUFFER_BYTE(                                         \
+		SSD1306_BUFFER_VIEW((handle)->buffer[(handle)->front]), \
+		x, page) /**< flushing byte */
+#define SSD1306_FRONT_BUFFER(handle) \
+	(&(handle)->buffer[(handle)->front][1]) /**< flushing buffer */
+#else
+#define SSD1306_GRAM(handle, x, page)                                 \
+	SSD1306_BUFFER_BYTE(SSD1306_BUFFER_VIEW((handle)->frame), x, \
+			    page) /**< drawing byte */
+#define SSD1306_FRONT(handle, x, page)                                \
+	SSD1306_BUFFER_BYTE(SSD1306_BUFFER_VIEW((handle)->frame), x, \
+			    page) /**< flushing byte */
+#define SSD1306_FRONT_BUFFER(handle) \
+	(&(handle)->frame[1]) /**< flushing buffer */
+#endif
+#define SSD1306_SHADOW(handle, x, page) \
+	SSD1306_BUFFER_BYTE((handle)->shadow, x, page) /**< shadow byte */
+#define SSD1306_GRAM_SIZE 1024 /**< gram size in bytes */
+
+/**
+ * @brief stats definition
+ */
+#if (SSD1306_STATS == 1)
+#define SSD1306_STATS_BUS(handle, cmd, len, res) \
+	a_ssd1306_stats_bus(handle, cmd, len, res) /**< count a transport call */
+#else
+#define SSD1306_STATS_BUS(handle, cmd, len, res) /**< no stats */
+#endif
+
+/**
+ * @brief trace definition
+ */
+#if (SSD1306_TRACE_SIZE > 0)
+#define SSD1306_TRACE(handle, cmd, buf, buf_len, len, res) \
+	a_ssd1306_trace(handle, cmd, buf, buf_len, len, \
+			res) /**< record a transport call */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && \
+	!defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define SSD1306_TRACE_RELEASE() \
+	atomic_thread_fence(memory_order_release) /**< order the entry stores */
+#define SSD1306_TRACE_ACQUIRE() \
+	atomic_thread_fence(memory_order_acquire) /**< order the entry loads */
+#elif defined(__GNUC__)
+#define SSD1306_TRACE_RELEASE() \
+	__atomic_thread_fence(__ATOMIC_RELEASE) /**< order the entry stores */
+#define SSD1306_TRACE_ACQUIRE() \
+	__atomic_thread_fence(__ATOMIC_ACQUIRE) /**< order the entry loads */
+#else
+#define SSD1306_TRACE_RELEASE() /**< single core, volatile count only */
+#define SSD1306_TRACE_ACQUIRE() /**< single core, volatile count only */
+#endif
+#else
+#define SSD1306_TRACE(handle, cmd, buf, buf_len, len, res) /**< no trace */
+#endif
+
+/**
+ * @brief     invalidate the shadow buffer
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] data is the write data
- * @param[in] cmd is the command or data type
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- * @note      none
+ * @note      the next diff update sends the whole gram
  */
-static uint8_t a_ssd1306_write_byte(ssd1306_handle_t *handle, uint8_t data,
-				    uint8_t cmd)
+static void a_ssd1306_shadow_invalidate(ssd1306_handle_t *handle)
 {
-	uint8_t res;
+#if (SSD1306_SHADOW_BUFFER == 1)
+	handle->shadow_valid = 0; /* set invalid */
+#else
+	(void)handle; /* no shadow */
+#endif
+}
 
-	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic */
+/**
+ * @brief     mark a gram column of one page as dirty
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] page is the page address
+ * @param[in] column is the column address
+ * @note      none
+ */
+static void a_ssd1306_mark_dirty(ssd1306_handle_t *handle, uint8_t page,
+				 uint8_t column)
+{
+	if (column < handle->dirty_start[page]) /* check start */
 	{
-		if (cmd != 0) /* if data */
-		{
-			if (handle->iic_write(handle->iic_addr, 0x40, &data,
-					      1) != 0) /* write data */
-			{
-				return 1; /* return error */
-			} else {
-				return 0; /* success return 0 */
-			}
-		} else {
-			if (handle->iic_write(handle->iic_addr, 0x00, &data,
-					      1) != 0) /* write command */
-			{
-				return 1; /* return error */
-			} else {
-				return 0; /* success return 0 */
-			}
-		}
-	} else if (handle->iic_spi == SSD1306_INTERFACE_SPI) /* if spi */
+		handle->dirty_start[page] = column; /* set start */
+	}
+	if (column > handle->dirty_end[page]) /* check end */
 	{
-		res = handle->spi_cmd_data_gpio_write(
-			cmd); /* write data command */
-		if (res != 0) /* check error */
-		{
-			return 1; /* return error */
-		}
+		handle->dirty_end[page] = column; /* set end */
+	}
+}
+
+/**
+ * @brief     set the dirty range of all pages
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] dirty is the dirty flag
+ * @note      a clean page has its start column after its end column
+ */
+static void a_ssd1306_set_dirty_all(ssd1306_handle_t *handle, uint8_t dirty)
+{
+	uint8_t i;
 
-		if (handle->spi_write_cmd(&data, 1) != 0) /* write command */
+	for (i = 0; i < 8; i++) /* set 8 page */
+	{
+		if (dirty != 0) /* if dirty */
 		{
-			return 1; /* return error */
+			handle->dirty_start[i] = 0x00; /* set first column */
+			handle->dirty_end[i] = 0x7F; /* set last column */
 		} else {
-			return 0; /* success return 0 */
+			handle->dirty_start[i] = 0xFF; /* set clean start */
+			handle->dirty_end[i] = 0x00; /* set clean end */
 		}
-	} else {
-		return 1; /* return error */
 	}
 }
 
+#if (SSD1306_STATS == 1)
 /**
- * @brief     write multiple bytes
+ * @brief     count a transport call
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] *data points to a data buffer
- * @param[in] len is the data length
  * @param[in] cmd is the command or data type
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- * @note      none
+ * @param[in] len is the byte length handed to the transport
+ * @param[in] res is the transport result
+ * @note      the bytes are only counted if the call succeeds
  */
-static uint8_t a_ssd1306_multiple_write_byte(ssd1306_handle_t *handle,
-					     uint8_t *data, uint8_t len,
-					     uint8_t cmd)
+static void a_ssd1306_stats_bus(ssd1306_handle_t *handle, uint8_t cmd,
+				uint16_t len, uint8_t res)
 {
-	uint8_t res;
-
-	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic */
+	if (cmd != 0) /* if data */
 	{
-		if (cmd != 0) /* if data */
-		{
-			if (handle->iic_write(handle->iic_addr, 0x40, data,
-					      len) != 0) /* write data */
-			{
-				return 1; /* return error */
-			} else {
-				return 0; /* success return 0 */
-			}
-		} else {
-			if (handle->iic_write(handle->iic_addr, 0x00, data,
-					      len) != 0) /* write command */
-			{
-				return 1; /* return error */
-			} else {
-				return 0; /* success return 0 */
-			}
-		}
-	} else if (handle->iic_spi == SSD1306_INTERFACE_SPI) /* if spi */
+		handle->stats.data_transaction++; /* count data */
+	} else {
+		handle->stats.command_transaction++; /* count command */
+	}
+	if (res != 0) /* check the result */
 	{
-		res = handle->spi_cmd_data_gpio_write(
-			cmd); /* write data command */
-		if (res != 0) /* check error */
-		{
-			return 1; /* return error */
-		}
-
-		if (handle->spi_write_cmd(data, len) != 0) /* write command */
-		{
-			return 1; /* return error */
-		} else {
-			return 0; /* success return 0 */
-		}
+		handle->stats.error++; /* count error */
 	} else {
-		return 1; /* return error */
+		handle->stats.byte += len; /* count bytes */
 	}
 }
 
 /**
- * @brief     draw a point in gram
+ * @brief     get the flush start time
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] x is the coordinate x
- * @param[in] y is the coordinate y
- * @param[in] data is the write data
- * @return    status code
- *            - 0 success
- *            - 1 gram draw point failed
- * @note      none
+ * @return    time in us
+ * @note      0 is returned without a linked timestamp_us
  */
-static uint8_t a_ssd1306_gram_draw_point(ssd1306_handle_t *handle, uint8_t x,
-					 uint8_t y, uint8_t data)
+static uint32_t a_ssd1306_stats_time(ssd1306_handle_t *handle)
 {
-	uint8_t pos;
-	uint8_t bx;
-	uint8_t temp = 0;
-
-	pos = y / 8; /* get y page */
-	bx = y % 8; /* get y point */
-	temp = 1 << bx; /* set data */
-	if (data != 0) /* if 1  */
+	if (handle->timestamp_us == NULL) /* check the hook */
 	{
-		handle->gram[x][pos] |= temp; /* set 1 */
-	} else {
-		handle->gram[x][pos] &= ~temp; /* set 0 */
+		return 0; /* no time */
 	}
 
-	return 0; /* success return 0 */
+	return handle->timestamp_us(); /* get the time */
 }
 
 /**
- * @brief     draw a char in gram
+ * @brief     count a flush
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] x is the coordinate x
- * @param[in] y is the coordinate y
- * @param[in] chr is the write char
- * @param[in] size is the char size
- * @param[in] mode is the display mode
- * @return    status code
- *            - 0 success
- *            - 1 gram show char failed
- * @note      none
+ * @param[in] start is the flush start time
+ * @note      the unsigned difference stays valid across the timestamp wrap
  */
-static uint8_t a_ssd1306_gram_show_char(ssd1306_handle_t *handle, uint8_t x,
-					uint8_t y, uint8_t chr, uint8_t size,
-					uint8_t mode)
+static void a_ssd1306_stats_flush(ssd1306_handle_t *handle, uint32_t start)
 {
-	uint8_t temp, t, t1;
-	uint8_t y0 = y;
-	uint8_t csize =
-		(size / 8 + ((size % 8) ? 1 : 0)) * (size / 2); /* get size */
+	uint32_t us;
 
-	chr = chr - ' '; /* get index */
-	for (t = 0; t < csize; t++) /* write size */
+	handle->stats.flush++; /* count flush */
+	if (handle->timestamp_us == NULL) /* check the hook */
 	{
-		if (size == 12) /* if size 12 */
-		{
-			temp = gsc_ssd1306_ascii_1206[chr]
-						     [t]; /* get ascii 1206 */
-		} else if (size == 16) /* if size 16 */
-		{
-			temp = gsc_ssd1306_ascii_1608[chr]
-						     [t]; /* get ascii 1608 */
-		} else if (size == 24) /* if size 24 */
-		{
-			temp = gsc_ssd1306_ascii_2412[chr]
-						     [t]; /* get ascii 2412 */
-		} else {
-			return 1; /* return error */
-		}
-		for (t1 = 0; t1 < 8; t1++) /* write one line */
-		{
-			if ((temp & 0x80) != 0) /* if 1 */
-			{
-				if (a_ssd1306_gram_draw_point(handle, x, y,
-							      mode) !=
-				    0) /* draw point */
-				{
-					return 1; /* return error */
-				}
-			} else {
-				if (a_ssd1306_gram_draw_point(handle, x, y,
-							      !mode) !=
-				    0) /* draw point */
-				{
-					return 1; /* return error */
-				}
-			}
-			temp <<= 1; /* left shift 1 */
-			y++;
-			if ((y - y0) == size) /* reset size */
-			{
-				y = y0; /* set y */
-				x++; /* x++ */
-
-				break; /* break */
-			}
-		}
+		return; /* no latency */
+	}
+	us = handle->timestamp_us() - start; /* get the latency */
+	handle->stats.flush_us += us; /* add the latency */
+	if (us > handle->stats.flush_us_max) /* check the max */
+	{
+		handle->stats.flush_us_max = us; /* save the max */
 	}
-
-	return 0; /* success return 0 */
 }
+#endif
 
+#if (SSD1306_TRACE_SIZE > 0)
 /**
- * @brief     clear the screen
+ * @brief     record a transport call in the trace
  * @param[in] *handle points to an ssd1306 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 clear failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @param[in] cmd is the command or data type
+ * @param[in] *buf points to the first bytes of the message
+ * @param[in] buf_len is the length of buf
+ * @param[in] len is the message length
+ * @param[in] res is the transport result
+ * @note      the slot is written after the last count and before the next one,
+ *            so a reader that checks the count after copying sees every entry
+ *            that was written meanwhile as overwritten
  */
-uint8_t ssd1306_clear(ssd1306_handle_t *handle)
+static void a_ssd1306_trace(ssd1306_handle_t *handle, uint8_t cmd,
+			    const uint8_t *buf, uint16_t buf_len, uint16_t len,
+			    uint8_t res)
 {
+	ssd1306_trace_entry_t *entry;
+	uint32_t count;
 	uint8_t i;
-	uint8_t n;
 
-	if (handle == NULL) /* check handle */
+	count = handle->trace_count; /* get the count */
+	SSD1306_TRACE_RELEASE(); /* the last count before the slot */
+	entry = &handle->trace[count % SSD1306_TRACE_SIZE]; /* get the slot */
+	entry->timestamp_us = (handle->timestamp_us != NULL) ?
+				      handle->timestamp_us() :
+				      0; /* set the time */
+	entry->len = len; /* set the length */
+	entry->kind = cmd; /* set the kind */
+	entry->res = res; /* set the result */
+	for (i = 0; i < SSD1306_TRACE_HEAD; i++) /* copy the first bytes */
+	{
+		entry->head[i] = (i < buf_len) ? buf[i] : 0x00; /* set the byte */
+	}
+	SSD1306_TRACE_RELEASE(); /* the slot before the count */
+	handle->trace_count = count + 1; /* publish the entry */
+}
+#endif
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+/**
+ * @brief     finish the asynchronous flush
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] res is the transfer result
+ * @note      a failed transfer leaves the chip ram unknown, the result is kept
+ *            until ssd1306_gram_update_async_poll or ssd1306_gram_update_async_wait
+ *            reports it
+ */
+static void a_ssd1306_async_finish(ssd1306_handle_t *handle, uint8_t res)
+{
+	handle->async_busy = 0; /* set idle */
+#if (SSD1306_STATS == 1)
+	if (res != 0) /* check the result */
 	{
-		return 2; /* return error */
+		handle->stats.error++; /* count error */
 	}
-	if (handle->inited != 1) /* check handle initialization */
+	a_ssd1306_stats_flush(handle, handle->async_start); /* count flush */
+#endif
+	if (res != 0) /* check the result */
 	{
-		return 3; /* return error */
+		handle->addressing_mode = 0xFF; /* addressing mode is unknown */
+		a_ssd1306_set_dirty_all(handle, 1); /* the chip ram is unknown */
+		a_ssd1306_shadow_invalidate(handle); /* the shadow is unknown */
 	}
+	handle->async_res = res; /* save the result */
+	handle->async_done = 1; /* the result is not reported yet */
+}
+
+/**
+ * @brief      check the asynchronous flush
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *busy points to a busy flag buffer
+ * @note       a finished transfer only frees the bus, the callback is not run
+ */
+static void a_ssd1306_async_check(ssd1306_handle_t *handle, uint8_t *busy)
+{
+	uint8_t res;
 
-	for (i = 0; i < 8; i++) /* write 8 page */
+	if (handle->async_busy == 0) /* check idle */
 	{
-		if (a_ssd1306_write_byte(handle, SSD1306_CMD_PAGE_ADDR + i,
-					 SSD1306_CMD) != 0) /* set page */
-		{
-			handle->debug_print(
-				"ssd1306: write byte failed.\n"); /* write byte failed */
+		*busy = 0; /* not busy */
 
-			return 1; /* return error */
-		}
-		if (a_ssd1306_write_byte(
-			    handle, SSD1306_CMD_LOWER_COLUMN_START_ADDRESS,
-			    SSD1306_CMD) != 0) /* set lower column 0 */
-		{
-			handle->debug_print(
-				"ssd1306: write byte failed.\n"); /* write byte failed */
+		return;
+	}
+	res = handle->async_poll(busy); /* poll the transport */
+	if (res != 0) /* check the result */
+	{
+		*busy = 0; /* the transfer is over */
+	}
+	if (*busy == 0) /* check finished */
+	{
+		a_ssd1306_async_finish(handle, res); /* finish */
+	}
+}
 
-			return 1; /* return error */
-		}
-		if (a_ssd1306_write_byte(
-			    handle, SSD1306_CMD_HIGHER_COLUMN_START_ADDRESS,
-			    SSD1306_CMD) != 0) /* set higher column 0 */
-		{
-			handle->debug_print(
-				"ssd1306: write byte failed.\n"); /* write byte failed */
+/**
+ * @brief     wait for the asynchronous flush
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @note      it is called before the driver uses the bus, the result is kept
+ *            for the next poll or wait
+ */
+static void a_ssd1306_async_wait(ssd1306_handle_t *handle)
+{
+	uint8_t busy;
 
-			return 1; /* return error */
-		}
-		for (n = 0; n < 128; n++) /* write 128 */
+	while (1) /* loop */
+	{
+		a_ssd1306_async_check(handle, &busy); /* check */
+		if (busy == 0) /* check finished */
 		{
-			handle->gram[n][i] = 0x00; /* set black */
-			if (a_ssd1306_write_byte(handle, handle->gram[n][i],
-						 SSD1306_DATA) !=
-			    0) /* write data */
-			{
-				handle->debug_print(
-					"ssd1306: write byte failed.\n"); /* write byte failed */
-
-				return 1; /* return error */
-			}
+			return; /* the bus is free */
 		}
+		handle->delay_ms(1); /* delay 1ms */
 	}
-
-	return 0; /* success return 0 */
 }
 
 /**
- * @brief     update the gram data
+ * @brief     report the finished asynchronous flush
  * @param[in] *handle points to an ssd1306 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 gram update failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 transfer failed
+ * @note      the callback runs once per update, after the result is cleared,
+ *            so it can start the next update
  */
-uint8_t ssd1306_gram_update(ssd1306_handle_t *handle)
+static uint8_t a_ssd1306_async_report(ssd1306_handle_t *handle)
 {
-	uint8_t i;
-	uint8_t n;
+	void (*callback)(uint8_t res);
+	uint8_t res;
 
-	if (handle == NULL) /* check handle */
+	if (handle->async_done == 0) /* check the result */
 	{
-		return 2; /* return error */
+		return 0; /* success return 0 */
 	}
-	if (handle->inited != 1) /* check handle initialization */
+	res = handle->async_res; /* get the result */
+	callback = handle->async_callback; /* get the callback */
+	handle->async_done = 0; /* reported */
+	if (callback != NULL) /* check the callback */
 	{
-		return 3; /* return error */
+		callback(res); /* run the callback */
 	}
 
-	for (i = 0; i < 8; i++) /* write 8 page */
+	return res; /* return the result */
+}
+#endif
+
+/**
+ * @brief     set the spi command data level
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] level is the command or data level
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio write failed
+ * @note      the gpio is only written when the level changes
+ */
+static uint8_t a_ssd1306_set_dc_level(ssd1306_handle_t *handle, uint8_t level)
+{
+	if (handle->dc_level == level) /* check the level */
 	{
-		if (a_ssd1306_write_byte(handle, SSD1306_CMD_PAGE_ADDR + i,
-					 SSD1306_CMD) != 0) /* set page */
-		{
-			handle->debug_print(
-				"ssd1306: write byte failed.\n"); /* write byte failed */
+		return 0; /* success return 0 */
+	}
+	if (handle->spi_cmd_data_gpio_write(level) != 0) /* write the level */
+	{
+		handle->dc_level = 0xFF; /* the level is unknown */
 
-			return 1; /* return error */
-		}
-		if (a_ssd1306_write_byte(
-			    handle, SSD1306_CMD_LOWER_COLUMN_START_ADDRESS,
-			    SSD1306_CMD) != 0) /* set lower column 0 */
-		{
-			handle->debug_print(
-				"ssd1306: write byte failed.\n"); /* write byte failed */
-
-			return 1; /* return error */
-		}
-		if (a_ssd1306_write_byte(
-			    handle, SSD1306_CMD_HIGHER_COLUMN_START_ADDRESS,
-			    SSD1306_CMD) != 0) /* set higher column 0 */
-		{
-			handle->debug_print(
-				"ssd1306: write byte failed.\n"); /* write byte failed */
-
-			return 1; /* return error */
-		}
-		for (n = 0; n < 128; n++) /* write 128 */
-		{
-			if (a_ssd1306_write_byte(handle, handle->gram[n][i],
-						 SSD1306_DATA) !=
-			    0) /* write data */
-			{
-				handle->debug_print(
-					"ssd1306: write byte failed.\n"); /* write byte failed */
-
-				return 1; /* return error */
-			}
-		}
-	}
+		return 1; /* return error */
+	}
+	handle->dc_level = level; /* save the level */
 
 	return 0; /* success return 0 */
 }
 
+#if (SSD1306_SPI_3WIRE == 1)
 /**
- * @brief     write a point
+ * @brief     submit the queued 3-wire spi messages
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] x is the coordinate x
- * @param[in] y is the coordinate y
- * @param[in] data is the write data
  * @return    status code
  *            - 0 success
- *            - 1 write point failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 x or y is invalid
- * @note      none
+ *            - 1 write failed
+ * @note      all messages go to spi_write_batch at once and the chip ram is
+ *            marked unknown if the batch fails
  */
-uint8_t ssd1306_write_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
-			    uint8_t data)
+static uint8_t a_ssd1306_spi_3wire_submit(ssd1306_handle_t *handle)
 {
-	uint8_t pos;
-	uint8_t bx;
-	uint8_t temp = 0;
+	uint8_t *buf[16];
+	uint16_t len[16];
+	uint16_t start;
+	uint8_t num;
+	uint8_t res;
+	uint8_t i;
 
-	if (handle == NULL) /* check handle */
+	if (handle->spi_3wire_seg_num == 0) /* check the queue */
 	{
-		return 2; /* return error */
+		return 0; /* success return 0 */
 	}
-	if (handle->inited != 1) /* check handle initialization */
+	num = handle->spi_3wire_seg_num; /* save the number */
+	handle->spi_3wire_seg_num = 0; /* clear the queue */
+	start = 0; /* init 0 */
+	for (i = 0; i < num; i++) /* set all segments */
 	{
-		return 3; /* return error */
+		buf[i] = &handle->spi_3wire_buf[start]; /* set the buffer */
+		len[i] = (uint16_t)(handle->spi_3wire_seg_end[i] -
+				    start); /* set the length */
+		start = handle->spi_3wire_seg_end[i]; /* next segment */
 	}
-	if ((x > 127) || (y > 63)) /* check x, y */
+	res = handle->spi_write_batch((uint8_t **)buf, (uint16_t *)len,
+				      num); /* write the batch */
+#if (SSD1306_STATS == 1)
+	for (i = 0; i < num; i++) /* count all segments */
 	{
-		handle->debug_print(
-			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+		a_ssd1306_stats_bus(handle,
+				    (uint8_t)((handle->spi_3wire_seg_data >> i) &
+					      0x01),
+				    len[i], res); /* count the segment */
+	}
+	handle->spi_3wire_seg_data = 0; /* clear the kinds */
+#endif
+	if (res != 0) /* check the result */
+	{
+		SSD1306_TRACE(handle, SSD1306_DATA, NULL, 0, start,
+			      res); /* the queued messages are lost */
+		handle->addressing_mode = 0xFF; /* the mode is unknown */
+		a_ssd1306_set_dirty_all(handle, 1); /* the chip ram is unknown */
+		a_ssd1306_shadow_invalidate(handle); /* invalidate */
 
-		return 4; /* return error */
+		return 1; /* return error */
 	}
 
-	pos = y / 8; /* get y page */
-	bx = y % 8; /* get y point */
-	temp = 1 << bx; /* set data */
-	if (data != 0) /* check the data */
-	{
-		handle->gram[x][pos] |= temp; /* set 1 */
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     write commands and data as packed 3-wire spi words
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *cmd points to a command buffer
+ * @param[in] cmd_len is the command length
+ * @param[in] *data points to a data buffer
+ * @param[in] data_len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      every byte becomes a 9-bit word with the command data bit
+ *            first, up to 1040 words go out in one transfer and the zero bits
+ *            that fill the last byte are dropped by the chip when cs rises,
+ *            while a spi batch is open the message is queued as one segment
+ */
+static uint8_t a_ssd1306_spi_3wire_write(ssd1306_handle_t *handle,
+					 uint8_t *cmd, uint16_t cmd_len,
+					 uint8_t *data, uint16_t data_len)
+{
+	uint32_t acc;
+	uint32_t total;
+	uint32_t need;
+	uint32_t i;
+	uint16_t word;
+	uint16_t pos;
+	uint8_t bits;
+	uint8_t queue;
+	uint8_t res;
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* the bus is owned by the asynchronous flush until it is over */
+#endif
+	total = (uint32_t)cmd_len + data_len; /* get the words */
+	need = (total * 9 + 7) / 8; /* get the packed length */
+	queue = 0; /* init 0 */
+	pos = 0; /* init 0 */
+	if ((handle->spi_3wire_batch == 1) &&
+	    (need <= sizeof(handle->spi_3wire_buf))) /* if the batch is open */
+	{
+		if (handle->spi_3wire_seg_num != 0) /* if queued */
+		{
+			pos = handle->spi_3wire_seg_end
+				      [handle->spi_3wire_seg_num - 1]; /* append */
+		}
+		if ((handle->spi_3wire_seg_num == 16) ||
+		    ((pos + need) >
+		     sizeof(handle->spi_3wire_buf))) /* check the free space */
+		{
+			if (a_ssd1306_spi_3wire_submit(handle) != 0) /* submit */
+			{
+				return 1; /* return error */
+			}
+			pos = 0; /* reset the position */
+		}
+		queue = 1; /* queue the message */
 	} else {
-		handle->gram[x][pos] &= ~temp; /* set 0 */
+		if (a_ssd1306_spi_3wire_submit(handle) !=
+		    0) /* keep the order of the queued messages */
+		{
+			return 1; /* return error */
+		}
 	}
-	if (a_ssd1306_write_byte(handle, SSD1306_CMD_PAGE_ADDR + pos,
-				 SSD1306_CMD) != 0) /* write page addr */
+	acc = 0; /* init 0 */
+	bits = 0; /* init 0 */
+	for (i = 0; i < total; i++) /* pack all words */
 	{
-		handle->debug_print(
-			"ssd1306: write byte failed.\n"); /* write byte failed */
-
-		return 1; /* return error */
+		if (i < cmd_len) /* if command */
+		{
+			word = cmd[i]; /* command word */
+		} else {
+			word = (uint16_t)(0x100 | data[i - cmd_len]); /* data word */
+		}
+		acc = (acc << 9) | word; /* append the word */
+		bits += 9; /* add 9 bits */
+		while (bits >= 8) /* output the full bytes */
+		{
+			bits -= 8; /* remove 8 bits */
+			handle->spi_3wire_buf[pos++] =
+				(uint8_t)(acc >> bits); /* set the byte */
+		}
+		acc &= (1U << bits) - 1; /* keep the rest */
+		if ((queue == 0) &&
+		    (pos == sizeof(handle->spi_3wire_buf))) /* if the buffer is full */
+		{
+			res = handle->spi_write_cmd(
+				(uint8_t *)handle->spi_3wire_buf,
+				pos); /* write the words */
+			SSD1306_STATS_BUS(handle, (uint8_t)(data_len != 0), pos,
+					  res);
+			if (res != 0) /* check the result */
+			{
+				return 1; /* return error */
+			}
+			pos = 0; /* reset the position */
+		}
 	}
-	if (a_ssd1306_write_byte(
-		    handle, SSD1306_CMD_LOWER_COLUMN_START_ADDRESS | (x & 0x0F),
-		    SSD1306_CMD) != 0) /* write lower column */
+	if (bits != 0) /* if a part of a byte is left */
 	{
-		handle->debug_print(
-			"ssd1306: write byte failed.\n"); /* write byte failed */
-
-		return 1; /* return error */
+		handle->spi_3wire_buf[pos++] =
+			(uint8_t)(acc << (8 - bits)); /* fill with zero bits */
 	}
-	if (a_ssd1306_write_byte(handle,
-				 SSD1306_CMD_HIGHER_COLUMN_START_ADDRESS |
-					 ((x > 4) & 0x0F),
-				 SSD1306_CMD) != 0) /* write higher column */
+	if (queue == 1) /* if queued */
 	{
-		handle->debug_print(
-			"ssd1306: write byte failed.\n"); /* write byte failed */
+#if (SSD1306_STATS == 1)
+		if (data_len != 0) /* if data */
+		{
+			handle->spi_3wire_seg_data |=
+				(uint16_t)(1U << handle->spi_3wire_seg_num); /* mark data */
+		}
+#endif
+		handle->spi_3wire_seg_end[handle->spi_3wire_seg_num++] =
+			pos; /* save the segment end */
 
-		return 1; /* return error */
+		return 0; /* success return 0 */
 	}
-	if (a_ssd1306_write_byte(handle, handle->gram[x][pos], SSD1306_DATA) !=
-	    0) /* write data */
+	if (pos != 0) /* if the words are left */
 	{
-		handle->debug_print(
-			"ssd1306: write byte failed.\n"); /* write byte failed */
-
-		return 1; /* return error */
-	} else {
-		return 0; /* success return 0 */
+		res = handle->spi_write_cmd((uint8_t *)handle->spi_3wire_buf,
+					    pos); /* write the words */
+		SSD1306_STATS_BUS(handle, (uint8_t)(data_len != 0), pos, res);
+		if (res != 0) /* check the result */
+		{
+			return 1; /* return error */
+		}
 	}
+
+	return 0; /* success return 0 */
 }
+#endif
 
 /**
- * @brief      read a point
- * @param[in]  *handle points to an ssd1306 handle structure
- * @param[in]  x is the coordinate x
- * @param[in]  y is the coordinate y
- * @param[out] *data points to a data buffer
- * @return     status code
- *             - 0 success
- *             - 1 read point failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 x or y is invalid
- * @note       none
+ * @brief     open a spi batch for the following messages
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @note      only 3-wire spi with a linked spi_write_batch queues messages
  */
-uint8_t ssd1306_read_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
-			   uint8_t *data)
+static void a_ssd1306_spi_batch_begin(ssd1306_handle_t *handle)
 {
-	uint8_t pos;
-	uint8_t bx;
-	uint8_t temp = 0;
-
-	if (handle == NULL) /* check handle */
-	{
-		return 2; /* return error */
-	}
-	if (handle->inited != 1) /* check handle initialization */
+#if (SSD1306_SPI_3WIRE == 1)
+	if ((handle->iic_spi == SSD1306_INTERFACE_SPI_3WIRE) &&
+	    (handle->spi_write_batch != NULL) &&
+	    (handle->batch_enable == 0)) /* check the batch path */
 	{
-		return 3; /* return error */
+		handle->spi_3wire_batch = 1; /* open the batch */
 	}
-	if ((x > 127) || (y > 63)) /* check x, y */
-	{
-		handle->debug_print(
-			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+#else
+	(void)handle;
+#endif
+}
 
-		return 4; /* return error */
-	}
+/**
+ * @brief     close the spi batch and submit the queued messages
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_spi_batch_end(ssd1306_handle_t *handle)
+{
+#if (SSD1306_SPI_3WIRE == 1)
+	handle->spi_3wire_batch = 0; /* close the batch */
 
-	pos = y / 8; /* get y page */
-	bx = y % 8; /* get y point */
-	temp = 1 << bx; /* set data */
-	if ((handle->gram[x][pos] & temp) != 0) /* get data */
-	{
-		*data = 1; /* set 1 */
-	} else {
-		*data = 0; /* set 0 */
-	}
+	return a_ssd1306_spi_3wire_submit(handle); /* submit */
+#else
+	(void)handle;
 
 	return 0; /* success return 0 */
+#endif
 }
 
 /**
- * @brief     write a point in the gram
+ * @brief     write multiple bytes to the bus
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] x is the coordinate x
- * @param[in] y is the coordinate y
- * @param[in] data is the write data
+ * @param[in] *data points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] cmd is the command or data type
  * @return    status code
  *            - 0 success
- *            - 1 gram write point failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 x or y is invalid
+ *            - 1 write failed
  * @note      none
  */
-uint8_t ssd1306_gram_write_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
-				 uint8_t data)
+static uint8_t a_ssd1306_bus_write(ssd1306_handle_t *handle, uint8_t *data,
+				   uint16_t len, uint8_t cmd)
 {
-	uint8_t pos;
-	uint8_t bx;
-	uint8_t temp = 0;
+	uint8_t res;
 
-	if (handle == NULL) /* check handle */
-	{
-		return 2; /* return error */
-	}
-	if (handle->inited != 1) /* check handle initialization */
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* the bus is owned by the asynchronous flush until it is over */
+#endif
+	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic */
 	{
-		return 3; /* return error */
-	}
-	if ((x > 127) || (y > 63)) /* check x, y */
+		if (cmd != 0) /* if data */
+		{
+			res = handle->iic_write(handle->iic_addr, 0x40, data,
+						len); /* write data */
+		} else {
+			res = handle->iic_write(handle->iic_addr, 0x00, data,
+						len); /* write command */
+		}
+		SSD1306_STATS_BUS(handle, cmd, (uint16_t)(len + 1), res);
+		SSD1306_TRACE(handle, cmd, data, len, len, res);
+		if (res != 0) /* check the result */
+		{
+			return 1; /* return error */
+		} else {
+			return 0; /* success return 0 */
+		}
+	} else if (handle->iic_spi == SSD1306_INTERFACE_SPI) /* if spi */
 	{
-		handle->debug_print(
-			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
-
-		return 4; /* return error */
-	}
+		res = a_ssd1306_set_dc_level(handle,
+					     cmd); /* write data command */
+		if (res != 0) /* check error */
+		{
+			return 1; /* return error */
+		}
 
-	pos = y / 8; /* get y page */
-	bx = y % 8; /* get y point */
-	temp = 1 << bx; /* set data */
-	if (data != 0) /* if 1 */
+		res = handle->spi_write_cmd(data, len); /* write command */
+		SSD1306_STATS_BUS(handle, cmd, len, res);
+		SSD1306_TRACE(handle, cmd, data, len, len, res);
+		if (res != 0) /* check the result */
+		{
+			return 1; /* return error */
+		} else {
+			return 0; /* success return 0 */
+		}
+#if (SSD1306_SPI_3WIRE == 1)
+	} else if (handle->iic_spi ==
+		   SSD1306_INTERFACE_SPI_3WIRE) /* if 3-wire spi */
 	{
-		handle->gram[x][pos] |= temp; /* set 1 */
+		if (cmd != 0) /* if data */
+		{
+			res = a_ssd1306_spi_3wire_write(handle, NULL, 0, data,
+							len); /* write data */
+		} else {
+			res = a_ssd1306_spi_3wire_write(handle, data, len, NULL,
+							0); /* write command */
+		}
+		SSD1306_TRACE(handle, cmd, data, len, len, res);
+
+		return res; /* return the result */
+#endif
 	} else {
-		handle->gram[x][pos] &= ~temp; /* set 0 */
+		return 1; /* return error */
 	}
-
-	return 0; /* success return 0 */
 }
 
 /**
- * @brief      read a point from the gram
- * @param[in]  *handle points to an ssd1306 handle structure
- * @param[in]  x is the coordinate x
- * @param[in]  y is the coordinate y
- * @param[out] *data points to a data buffer
- * @return     status code
- *             - 0 success
- *             - 1 gram read point failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 x or y is invalid
- * @note       none
+ * @brief     send the queued batch commands
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
  */
-uint8_t ssd1306_gram_read_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
-				uint8_t *data)
+static uint8_t a_ssd1306_batch_flush(ssd1306_handle_t *handle)
 {
-	uint8_t pos;
-	uint8_t bx;
-	uint8_t temp = 0;
+	uint8_t len;
 
-	if (handle == NULL) /* check handle */
-	{
-		return 2; /* return error */
-	}
-	if (handle->inited != 1) /* check handle initialization */
+	if (handle->batch_len == 0) /* check the queue */
 	{
-		return 3; /* return error */
+		return 0; /* success return 0 */
 	}
-	if ((x > 127) || (y > 63)) /* check x, y */
-	{
-		handle->debug_print(
-			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+	len = handle->batch_len; /* save the length */
+	handle->batch_len = 0; /* clear the queue */
 
-		return 4; /* return error */
-	}
+	return a_ssd1306_bus_write(handle, (uint8_t *)handle->batch_buf, len,
+				   SSD1306_CMD); /* write command */
+}
 
-	pos = y / 8; /* get y page */
-	bx = y % 8; /* get y point */
-	temp = 1 << bx; /* set data */
-	if ((handle->gram[x][pos] & temp) != 0) /* get data */
+/**
+ * @brief     write multiple bytes while a batch is active
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *data points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] cmd is the command or data type
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      commands are queued and any data write sends the queue first
+ */
+static uint8_t a_ssd1306_batch_write(ssd1306_handle_t *handle, uint8_t *data,
+				     uint16_t len, uint8_t cmd)
+{
+	if ((cmd == SSD1306_CMD) &&
+	    (len <= SSD1306_COMMAND_BATCH_SIZE)) /* if command */
 	{
-		*data = 1; /* set 1 */
-	} else {
-		*data = 0; /* set 0 */
+		if ((handle->batch_len + len) >
+		    SSD1306_COMMAND_BATCH_SIZE) /* check the free space */
+		{
+			if (a_ssd1306_batch_flush(handle) != 0) /* flush */
+			{
+				return 1; /* return error */
+			}
+		}
+		memcpy(&handle->batch_buf[handle->batch_len], data,
+		       len); /* queue the command */
+		handle->batch_len += (uint8_t)len; /* add the length */
+
+		return 0; /* success return 0 */
+	}
+	if (a_ssd1306_batch_flush(handle) != 0) /* flush */
+	{
+		return 1; /* return error */
 	}
 
-	return 0; /* success return 0 */
+	return a_ssd1306_bus_write(handle, data, len, cmd); /* write */
 }
 
 /**
- * @brief     draw a string in the gram
+ * @brief     write one byte
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] x is the coordinate x
- * @param[in] y is the coordinate y
- * @param[in] *str points to a write string address
- * @param[in] len is the length of the string
- * @param[in] color is the display color
- * @param[in] font is the display font size
+ * @param[in] data is the write data
+ * @param[in] cmd is the command or data type
  * @return    status code
  *            - 0 success
- *            - 1 gram write string failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 x or y is invalid
+ *            - 1 write failed
  * @note      none
  */
-uint8_t ssd1306_gram_write_string(ssd1306_handle_t *handle, uint8_t x,
-				  uint8_t y, char *str, uint16_t len,
-				  uint8_t color, ssd1306_font_t font)
+static uint8_t a_ssd1306_write_byte(ssd1306_handle_t *handle, uint8_t data,
+				    uint8_t cmd)
 {
-	if (handle == NULL) /* check handle */
-	{
-		return 2; /* return error */
-	}
-	if (handle->inited != 1) /* check handle initialization */
-	{
-		return 3; /* return error */
-	}
-	if ((x > 127) || (y > 63)) /* check x, y */
-	{
-		handle->debug_print(
-			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+	uint8_t res;
 
-		return 4; /* return error */
+	if (handle->batch_enable == 1) /* if batch */
+	{
+		return a_ssd1306_batch_write(handle, &data, 1, cmd); /* queue */
 	}
-
-	while ((len != 0) && (*str <= '~') &&
-	       (*str >= ' ')) /* write all string */
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* the bus is owned by the asynchronous flush until it is over */
+#endif
+	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic */
 	{
-		if (x > (127 - (font / 2))) /* check x point */
+		if (cmd != 0) /* if data */
 		{
-			x = 0; /* set x */
-			y += (uint8_t)font; /* set next row */
+			res = handle->iic_write(handle->iic_addr, 0x40, &data,
+						1); /* write data */
+		} else {
+			res = handle->iic_write(handle->iic_addr, 0x00, &data,
+						1); /* write command */
 		}
-		if (y > (63 - font)) /* check y pont */
+		SSD1306_STATS_BUS(handle, cmd, 2, res);
+		SSD1306_TRACE(handle, cmd, &data, 1, 1, res);
+		if (res != 0) /* check the result */
 		{
-			y = x = 0; /* reset to 0,0 */
+			return 1; /* return error */
+		} else {
+			return 0; /* success return 0 */
 		}
-		if (a_ssd1306_gram_show_char(handle, x, y, *str, font, color) !=
-		    0) /* show a char */
+	} else if (handle->iic_spi == SSD1306_INTERFACE_SPI) /* if spi */
+	{
+		res = a_ssd1306_set_dc_level(handle,
+					     cmd); /* write data command */
+		if (res != 0) /* check error */
 		{
 			return 1; /* return error */
 		}
-		x += (uint8_t)(font / 2); /* x + font/2 */
-		str++; /* str address++ */
-		len--; /* str length-- */
-	}
 
-	return 0; /* success return 0 */
+		res = handle->spi_write_cmd(&data, 1); /* write command */
+		SSD1306_STATS_BUS(handle, cmd, 1, res);
+		SSD1306_TRACE(handle, cmd, &data, 1, 1, res);
+		if (res != 0) /* check the result */
+		{
+			return 1; /* return error */
+		} else {
+			return 0; /* success return 0 */
+		}
+#if (SSD1306_SPI_3WIRE == 1)
+	} else if (handle->iic_spi ==
+		   SSD1306_INTERFACE_SPI_3WIRE) /* if 3-wire spi */
+	{
+		if (cmd != 0) /* if data */
+		{
+			res = a_ssd1306_spi_3wire_write(handle, NULL, 0, &data,
+							1); /* write data */
+		} else {
+			res = a_ssd1306_spi_3wire_write(handle, &data, 1, NULL,
+							0); /* write command */
+		}
+		SSD1306_TRACE(handle, cmd, &data, 1, 1, res);
+
+		return res; /* return the result */
+#endif
+	} else {
+		return 1; /* return error */
+	}
 }
 
+
 /**
- * @brief     fill a rectangle in the gram
+ * @brief     write multiple bytes
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] left is the left coordinate x
- * @param[in] top is the top coordinate y
- * @param[in] right is the right coordinate x
- * @param[in] bottom is the bottom coordinate y
- * @param[in] color is the display color
+ * @param[in] *data points to a data buffer
+ * @param[in] len is the data length
+ * @param[in] cmd is the command or data type
  * @return    status code
  *            - 0 success
- *            - 1 gram fill rect failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 left or top is invalid
- *            - 5 right or bottom is invalid
- *            - 6 left > right or top > bottom
+ *            - 1 write failed
  * @note      none
  */
-uint8_t ssd1306_gram_fill_rect(ssd1306_handle_t *handle, uint8_t left,
-			       uint8_t top, uint8_t right, uint8_t bottom,
-			       uint8_t color)
+static uint8_t a_ssd1306_multiple_write_byte(ssd1306_handle_t *handle,
+					     uint8_t *data, uint16_t len,
+					     uint8_t cmd)
 {
-	uint8_t x, y;
-
-	if (handle == NULL) /* check handle */
-	{
-		return 2; /* return error */
-	}
-	if (handle->inited != 1) /* check handle initialization */
+	if (handle->batch_enable == 1) /* if batch */
 	{
-		return 3; /* return error */
+		return a_ssd1306_batch_write(handle, data, len, cmd); /* queue */
 	}
-	if ((left > 127) || (top > 63)) /* check left top */
-	{
-		handle->debug_print(
-			"ssd1306: left or top is invalid.\n"); /* left or top is invalid */
 
-		return 4; /* return error */
-	}
-	if ((right > 127) || (bottom > 63)) /* check right bottom */
-	{
-		handle->debug_print(
-			"ssd1306: right or bottom is invalid.\n"); /* right or bottom is invalid */
+	return a_ssd1306_bus_write(handle, data, len, cmd); /* write */
+}
 
-		return 5; /* return error */
-	}
-	if ((left > right) || (top > bottom)) /* check left right top bottom */
-	{
-		handle->debug_print(
-			"ssd1306: left > right or top > bottom.\n"); /* left > right or top > bottom */
+/**
+ * @brief     check the headroom write path
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    1 if a_ssd1306_headroom_write uses the headroom, else 0
+ * @note      none
+ */
+static uint8_t a_ssd1306_headroom_ready(ssd1306_handle_t *handle)
+{
+	return (uint8_t)((handle->batch_enable != 1) &&
+			 (handle->iic_spi == SSD1306_INTERFACE_IIC) &&
+			 (handle->iic_write_headroom !=
+			  NULL)); /* check the headroom path */
+}
 
-		return 6; /* return error */
+/**
+ * @brief     write multiple bytes from a buffer with one byte of headroom
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *data points to a data buffer preceded by one headroom byte
+ * @param[in] len is the data length
+ * @param[in] cmd is the command or data type
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the control byte is stored in the headroom, so the buffer goes to
+ *            the iic bus without any copy, the headroom is not touched on the
+ *            other paths
+ */
+static uint8_t a_ssd1306_headroom_write(ssd1306_handle_t *handle,
+					uint8_t *data, uint16_t len,
+					uint8_t cmd)
+{
+	uint8_t res;
+
+	if (a_ssd1306_headroom_ready(handle) == 0) /* check the headroom path */
+	{
+		return a_ssd1306_multiple_write_byte(handle, data, len,
+						     cmd); /* write */
 	}
 
-	for (x = left; x <= right; x++) /* write x */
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* the bus is owned by the asynchronous flush until it is over */
+#endif
+	data[-1] = (cmd != 0) ? 0x40 : 0x00; /* set the control byte */
+	res = handle->iic_write_headroom(handle->iic_addr, data - 1,
+					 (uint16_t)(len + 1)); /* write */
+	SSD1306_STATS_BUS(handle, cmd, (uint16_t)(len + 1), res);
+	SSD1306_TRACE(handle, cmd, data, len, len, res);
+	if (res != 0) /* check the result */
 	{
-		for (y = top; y <= bottom; y++) /* write y */
-		{
-			if (a_ssd1306_gram_draw_point(handle, x, y, color) !=
-			    0) /* draw point */
-			{
-				return 1; /* return error */
-			}
-		}
+		return 1; /* return error */
 	}
 
-	return 0; /* return error */
+	return 0; /* success return 0 */
 }
 
 /**
- * @brief     draw a picture in the gram
+ * @brief     write commands and data in one transaction
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] left is the left coordinate x
- * @param[in] top is the top coordinate y
- * @param[in] right is the right coordinate x
- * @param[in] bottom is the bottom coordinate y
- * @param[in] *img points to an image buffer
+ * @param[in] *cmd points to a command buffer
+ * @param[in] cmd_len is the command length
+ * @param[in] *data points to a data buffer
+ * @param[in] data_len is the data length
  * @return    status code
  *            - 0 success
- *            - 1 gram draw picture failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 left or top is invalid
- *            - 5 right or bottom is invalid
- *            - 6 left > right or top > bottom
- * @note      none
+ *            - 1 write failed
+ * @note      on iic every command gets a control byte with the co bit and
+ *            the last control byte starts the data stream, 3-wire spi packs
+ *            both into one transfer, otherwise the commands and the data are
+ *            written one after the other
  */
-uint8_t ssd1306_gram_draw_picture(ssd1306_handle_t *handle, uint8_t left,
-				  uint8_t top, uint8_t right, uint8_t bottom,
-				  uint8_t *img)
+static uint8_t a_ssd1306_mixed_write(ssd1306_handle_t *handle, uint8_t *cmd,
+				     uint16_t cmd_len, uint8_t *data,
+				     uint16_t data_len)
 {
-	uint8_t x, y;
+	uint8_t buf[SSD1306_IIC_MIXED_CMD_MAX * 2 + SSD1306_IIC_MIXED_DATA_MAX +
+		    1];
+	uint16_t len;
+	uint16_t i;
+	uint8_t res;
 
-	if (handle == NULL) /* check handle */
+#if (SSD1306_SPI_3WIRE == 1)
+	if ((handle->iic_spi == SSD1306_INTERFACE_SPI_3WIRE) &&
+	    (handle->batch_enable == 0)) /* if 3-wire spi */
 	{
-		return 2; /* return error */
+		res = a_ssd1306_spi_3wire_write(handle, cmd, cmd_len, data,
+						data_len); /* write the words */
+		SSD1306_TRACE(handle, (uint8_t)(data_len != 0), cmd, cmd_len,
+			      (uint16_t)(cmd_len + data_len), res);
+
+		return res; /* return the result */
 	}
-	if (handle->inited != 1) /* check handle initialization */
+#endif
+	if ((handle->iic_spi != SSD1306_INTERFACE_IIC) ||
+	    (handle->batch_enable == 1) || (cmd_len == 0) ||
+	    (data_len == 0) || (cmd_len > SSD1306_IIC_MIXED_CMD_MAX) ||
+	    (data_len > SSD1306_IIC_MIXED_DATA_MAX)) /* check the message */
 	{
-		return 3; /* return error */
+		if (cmd_len != 0) /* if command */
+		{
+			if (a_ssd1306_multiple_write_byte(handle, cmd, cmd_len,
+							  SSD1306_CMD) !=
+			    0) /* write command */
+			{
+				return 1; /* return error */
+			}
+		}
+		if (data_len != 0) /* if data */
+		{
+			if (a_ssd1306_multiple_write_byte(handle, data,
+							  data_len,
+							  SSD1306_DATA) !=
+			    0) /* write data */
+			{
+				return 1; /* return error */
+			}
+		}
+
+		return 0; /* success return 0 */
 	}
-	if ((left > 127) || (top > 63)) /* check left top */
-	{
-		handle->debug_print(
-			"ssd1306: left or top is invalid.\n"); /* left or top is invalid */
 
-		return 4; /* return error */
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* the bus is owned by the asynchronous flush until it is over */
+#endif
+	len = 0; /* init 0 */
+	buf[len++] = 0x80; /* the first control byte */
+	buf[len++] = cmd[0]; /* set the first command */
+	for (i = 1; i < cmd_len; i++) /* copy the commands */
+	{
+		buf[len++] = 0x80; /* command with continuation */
+		buf[len++] = cmd[i]; /* set the command */
 	}
-	if ((right > 127) || (bottom > 63)) /* check right bottom */
+	buf[len++] = 0x40; /* the data stream follows */
+	memcpy(&buf[len], data, data_len); /* copy the data */
+	len += data_len; /* add the data length */
+	if (handle->iic_write_headroom != NULL) /* if headroom */
 	{
-		handle->debug_print(
-			"ssd1306: right or bottom is invalid.\n"); /* right or bottom is invalid */
-
-		return 5; /* return error */
+		res = handle->iic_write_headroom(handle->iic_addr,
+						 (uint8_t *)buf,
+						 len); /* write the message */
+	} else {
+		res = handle->iic_write(handle->iic_addr, buf[0],
+					(uint8_t *)&buf[1],
+					(uint16_t)(len - 1)); /* write the message */
 	}
-	if ((left > right) || (top > bottom)) /* check left right top bottom */
+	SSD1306_STATS_BUS(handle, SSD1306_DATA, len, res);
+	SSD1306_TRACE(handle, SSD1306_DATA, cmd, cmd_len,
+		      (uint16_t)(cmd_len + data_len), res);
+	if (res != 0) /* check the result */
 	{
-		handle->debug_print(
-			"ssd1306: left > right or top > bottom.\n"); /* left > right or top > bottom */
-
-		return 6; /* return error */
+		return 1; /* return error */
 	}
 
-	for (x = left; x <= right; x++) /* write x */
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      build the page addressing commands
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[in]  page is the page address
+ * @param[in]  column is the column address
+ * @param[out] *buf points to a command buffer with 5 bytes
+ * @return     command length
+ * @note       the page addressing mode is restored first if a frame flush
+ *             changed it
+ */
+static uint8_t a_ssd1306_position_command(ssd1306_handle_t *handle,
+					  uint8_t page, uint8_t column,
+					  uint8_t *buf)
+{
+	uint8_t len;
+
+	len = 0; /* init 0 */
+	if (handle->addressing_mode !=
+	    SSD1306_MEMORY_ADDRESSING_MODE_PAGE) /* check addressing mode */
 	{
-		for (y = top; y <= bottom; y++) /* write y */
-		{
-			if (a_ssd1306_gram_draw_point(handle, x, y, *img) !=
-			    0) /* draw point */
-			{
-				return 1; /* return error */
-			}
-			img++; /* img++ */
-		}
+		buf[len++] =
+			SSD1306_CMD_MEMORY_ADDRESSING_MODE; /* set addressing mode */
+		buf[len++] = SSD1306_MEMORY_ADDRESSING_MODE_PAGE; /* page mode */
 	}
+	buf[len++] = SSD1306_CMD_PAGE_ADDR + (page & 0x07); /* set page */
+	buf[len++] = SSD1306_CMD_LOWER_COLUMN_START_ADDRESS |
+		     (column & 0x0F); /* set lower column */
+	buf[len++] = SSD1306_CMD_HIGHER_COLUMN_START_ADDRESS |
+		     ((column >> 4) & 0x0F); /* set higher column */
 
-	return 0; /* succeed return 0 */
+	return len; /* return the length */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     set the page and column address in page addressing mode
  * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] page is the page address
+ * @param[in] column is the column address
  * @return    status code
  *            - 0 success
- *            - 1 iic or spi initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 reset failed
- *            - 5 command && data init failed
- *            - 6 interface param is invalid
- * @note      none
+ *            - 1 write failed
+ * @note      the address commands are sent in one transaction and the page
+ *            addressing mode is restored first if a frame flush changed it
  */
-uint8_t ssd1306_init(ssd1306_handle_t *handle)
+static uint8_t a_ssd1306_set_position(ssd1306_handle_t *handle, uint8_t page,
+				      uint8_t column)
 {
-	if (handle == NULL) /* check handle */
+	uint8_t buf[5];
+	uint8_t len;
+
+	len = a_ssd1306_position_command(handle, page, column,
+					 (uint8_t *)buf); /* build */
+	if (a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, len,
+					  SSD1306_CMD) != 0) /* write command */
+	{
+		return 1; /* return error */
+	}
+	handle->addressing_mode =
+		SSD1306_MEMORY_ADDRESSING_MODE_PAGE; /* save addressing mode */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     write a column range of one page from the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] page is the page address
+ * @param[in] start is the start column
+ * @param[in] end is the end column
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      start <= end <= 127
+ */
+static uint8_t a_ssd1306_write_page(ssd1306_handle_t *handle, uint8_t page,
+				    uint8_t start, uint8_t end)
+{
+	uint8_t buf[129];
+	uint8_t cmd[5];
+	uint8_t *data;
+	uint8_t len;
+	uint8_t i;
+
+	if (handle->flush_mode == SSD1306_FLUSH_MODE_BYTE) /* if byte mode */
+	{
+		if (handle->addressing_mode !=
+		    SSD1306_MEMORY_ADDRESSING_MODE_PAGE) /* check addressing mode */
+		{
+			if (a_ssd1306_write_byte(handle,
+						 SSD1306_CMD_MEMORY_ADDRESSING_MODE,
+						 SSD1306_CMD) != 0) /* set mode */
+			{
+				return 1; /* return error */
+			}
+			if (a_ssd1306_write_byte(
+				    handle, SSD1306_MEMORY_ADDRESSING_MODE_PAGE,
+				    SSD1306_CMD) != 0) /* page mode */
+			{
+				return 1; /* return error */
+			}
+			handle->addressing_mode =
+				SSD1306_MEMORY_ADDRESSING_MODE_PAGE; /* save mode */
+		}
+		if (a_ssd1306_write_byte(handle, SSD1306_CMD_PAGE_ADDR + page,
+					 SSD1306_CMD) != 0) /* set page */
+		{
+			return 1; /* return error */
+		}
+		if (a_ssd1306_write_byte(
+			    handle,
+			    SSD1306_CMD_LOWER_COLUMN_START_ADDRESS |
+				    (start & 0x0F),
+			    SSD1306_CMD) != 0) /* set lower column */
+		{
+			return 1; /* return error */
+		}
+		if (a_ssd1306_write_byte(
+			    handle,
+			    SSD1306_CMD_HIGHER_COLUMN_START_ADDRESS |
+				    ((start >> 4) & 0x0F),
+			    SSD1306_CMD) != 0) /* set higher column */
+		{
+			return 1; /* return error */
+		}
+		for (i = start; i <= end; i++) /* write the range */
+		{
+			if (a_ssd1306_write_byte(handle,
+						 SSD1306_FRONT(handle, i, page),
+						 SSD1306_DATA) !=
+			    0) /* write data */
+			{
+				a_ssd1306_shadow_invalidate(handle); /* invalidate */
+
+				return 1; /* return error */
+			}
+		}
+	} else if ((handle->iic_transport ==
+		    SSD1306_IIC_TRANSPORT_CONTINUATION) ||
+		   (handle->iic_spi ==
+		    SSD1306_INTERFACE_SPI_3WIRE)) /* if one message */
+	{
+		len = a_ssd1306_position_command(handle, page, start,
+						 (uint8_t *)cmd); /* build */
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+		if (a_ssd1306_mixed_write(handle, (uint8_t *)cmd, len,
+					  &SSD1306_FRONT(handle, start, page),
+					  (uint16_t)(end - start + 1)) !=
+		    0) /* write the message from the gram */
+#else
+		for (i = start; i <= end; i++) /* gather the page bytes */
+		{
+			buf[i - start + 1] =
+				SSD1306_FRONT(handle, i, page); /* copy the column */
+		}
+		if (a_ssd1306_mixed_write(handle, (uint8_t *)cmd, len,
+					  (uint8_t *)&buf[1],
+					  (uint16_t)(end - start + 1)) !=
+		    0) /* write the message */
+#endif
+		{
+			handle->addressing_mode = 0xFF; /* the mode is unknown */
+			a_ssd1306_shadow_invalidate(handle); /* invalidate */
+
+			return 1; /* return error */
+		}
+		handle->addressing_mode =
+			SSD1306_MEMORY_ADDRESSING_MODE_PAGE; /* save addressing mode */
+	} else {
+		if (a_ssd1306_set_position(handle, page, start) !=
+		    0) /* set position */
+		{
+			return 1; /* return error */
+		}
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+		data = &SSD1306_FRONT(handle, start,
+				      page); /* the page is contiguous */
+		if (a_ssd1306_headroom_ready(handle) != 0) /* if headroom */
+		{
+			memcpy(&buf[1], data,
+			       (size_t)(end - start + 1)); /* copy after the headroom */
+			data = (uint8_t *)&buf[1]; /* send the copy */
+		}
+#else
+		for (i = start; i <= end; i++) /* gather the page bytes */
+		{
+			buf[i - start + 1] =
+				SSD1306_FRONT(handle, i, page); /* copy the column */
+		}
+		data = (uint8_t *)&buf[1]; /* send the gathered bytes */
+#endif
+		if (a_ssd1306_headroom_write(handle, data,
+					     (uint16_t)(end - start + 1),
+					     SSD1306_DATA) != 0) /* write data */
+		{
+			a_ssd1306_shadow_invalidate(handle); /* invalidate */
+
+			return 1; /* return error */
+		}
+	}
+#if (SSD1306_SHADOW_BUFFER == 1)
+	for (i = start; i <= end; i++) /* update the shadow */
+	{
+		SSD1306_SHADOW(handle, i, page) =
+			SSD1306_FRONT(handle, i, page); /* copy */
+	}
+#endif
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      build the frame addressing commands
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *buf points to a command buffer with 8 bytes
+ * @return     command length
+ * @note       none
+ */
+static uint8_t a_ssd1306_frame_command(ssd1306_handle_t *handle, uint8_t *buf)
+{
+	uint8_t len;
+
+	len = 0; /* init 0 */
+	if (handle->addressing_mode !=
+	    SSD1306_FRAME_ADDRESSING_MODE) /* check addressing mode */
+	{
+		buf[len++] =
+			SSD1306_CMD_MEMORY_ADDRESSING_MODE; /* set addressing mode */
+		buf[len++] = SSD1306_FRAME_ADDRESSING_MODE; /* frame mode */
+	}
+	buf[len++] = SSD1306_CMD_SET_COLUMN_ADDRESS; /* set column address */
+	buf[len++] = 0x00; /* column start */
+	buf[len++] = 0x7F; /* column end */
+	buf[len++] = SSD1306_CMD_SET_PAGE_ADDRESS; /* set page address */
+	buf[len++] = 0x00; /* page start */
+	buf[len++] = 0x07; /* page end */
+
+	return len; /* return the length */
+}
+
+/**
+ * @brief     write the whole gram in one data transfer
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the addressing mode follows the gram layout, so the gram is
+ *            streamed in memory order without any copy and the headroom byte
+ *            before the buffer holds the control byte
+ */
+static uint8_t a_ssd1306_write_frame(ssd1306_handle_t *handle)
+{
+	uint8_t buf[8];
+	uint8_t len;
+
+	len = a_ssd1306_frame_command(handle, (uint8_t *)buf); /* build */
+	if (handle->iic_spi == SSD1306_INTERFACE_SPI_3WIRE) /* if 3-wire spi */
+	{
+		if (a_ssd1306_mixed_write(handle, (uint8_t *)buf, len,
+					  SSD1306_FRONT_BUFFER(handle),
+					  SSD1306_GRAM_SIZE) !=
+		    0) /* write the frame in one transfer */
+		{
+			handle->addressing_mode = 0xFF; /* the mode is unknown */
+			a_ssd1306_shadow_invalidate(handle); /* invalidate */
+
+			return 1; /* return error */
+		}
+		handle->addressing_mode =
+			SSD1306_FRAME_ADDRESSING_MODE; /* save addressing mode */
+#if (SSD1306_SHADOW_BUFFER == 1)
+		memcpy(handle->shadow, SSD1306_FRONT_BUFFER(handle),
+		       SSD1306_GRAM_SIZE); /* update the shadow */
+#endif
+
+		return 0; /* success return 0 */
+	}
+	if (a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, len,
+					  SSD1306_CMD) != 0) /* write command */
+	{
+		return 1; /* return error */
+	}
+	handle->addressing_mode =
+		SSD1306_FRAME_ADDRESSING_MODE; /* save addressing mode */
+
+	if (a_ssd1306_headroom_write(handle, SSD1306_FRONT_BUFFER(handle),
+				     SSD1306_GRAM_SIZE,
+				     SSD1306_DATA) != 0) /* write data */
+	{
+		a_ssd1306_shadow_invalidate(handle); /* invalidate */
+
+		return 1; /* return error */
+	}
+#if (SSD1306_SHADOW_BUFFER == 1)
+	memcpy(handle->shadow, SSD1306_FRONT_BUFFER(handle),
+	       SSD1306_GRAM_SIZE); /* update the shadow */
+#endif
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     write the whole gram with the current flush mode
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      spi page mode also sends the whole gram as one frame, so all
+ *            commands go before all data with at most two level changes
+ */
+static uint8_t a_ssd1306_write_gram(ssd1306_handle_t *handle)
+{
+	uint8_t i;
+
+	if ((handle->flush_mode == SSD1306_FLUSH_MODE_FRAME) ||
+	    ((handle->flush_mode == SSD1306_FLUSH_MODE_PAGE) &&
+	     (handle->iic_spi !=
+	      SSD1306_INTERFACE_IIC))) /* if frame mode or spi page mode */
+	{
+		if (a_ssd1306_write_frame(handle) != 0) /* write frame */
+		{
+			return 1; /* return error */
+		}
+	} else {
+		a_ssd1306_spi_batch_begin(handle); /* open the spi batch */
+		for (i = 0; i < 8; i++) /* write 8 page */
+		{
+			if (a_ssd1306_write_page(handle, i, 0, 127) !=
+			    0) /* write page */
+			{
+				(void)a_ssd1306_spi_batch_end(handle); /* close */
+
+				return 1; /* return error */
+			}
+		}
+		if (a_ssd1306_spi_batch_end(handle) != 0) /* submit */
+		{
+			return 1; /* return error */
+		}
+	}
+#if (SSD1306_SHADOW_BUFFER == 1)
+	handle->shadow_valid = 1; /* the shadow matches the chip ram */
+#endif
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     fill the masked bits of a column span in one gram page
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] page is the page address
+ * @param[in] left is the first column
+ * @param[in] right is the last column
+ * @param[in] mask is the bit mask of the page rows
+ * @param[in] color is the fill color
+ * @note      only the changed columns are marked dirty
+ */
+static void a_ssd1306_gram_fill_span(ssd1306_handle_t *handle, uint8_t page,
+				     uint8_t left, uint8_t right, uint8_t mask,
+				     uint8_t color)
+{
+	uint8_t x;
+	uint8_t first;
+	uint8_t last;
+	uint8_t prev;
+	uint8_t value;
+
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+	if (mask == 0xFF) /* if the whole page rows */
+	{
+		value = (color != 0) ? 0xFF : 0x00; /* get the byte */
+		first = left; /* init first */
+		while ((first <= right) &&
+		       (SSD1306_GRAM(handle, first, page) ==
+			value)) /* skip the same head */
+		{
+			first++; /* next column */
+		}
+		if (first > right) /* if no change */
+		{
+			return; /* nothing to do */
+		}
+		last = right; /* init last */
+		while (SSD1306_GRAM(handle, last, page) ==
+		       value) /* skip the same tail */
+		{
+			last--; /* previous column */
+		}
+		memset(&SSD1306_GRAM(handle, first, page), value,
+		       (size_t)(last - first + 1)); /* fill the row */
+		a_ssd1306_mark_dirty(handle, page, first); /* mark first */
+		a_ssd1306_mark_dirty(handle, page, last); /* mark last */
+
+		return;
+	}
+#endif
+	first = 0xFF; /* no change */
+	last = 0; /* no change */
+	for (x = left; x <= right; x++) /* fill the columns */
+	{
+		prev = SSD1306_GRAM(handle, x, page); /* save the old byte */
+		if (color != 0) /* if 1 */
+		{
+			value = prev | mask; /* set 1 */
+		} else {
+			value = prev & (uint8_t)(~mask); /* set 0 */
+		}
+		if (value != prev) /* check changed */
+		{
+			SSD1306_GRAM(handle, x, page) = value; /* set the byte */
+			if (first == 0xFF) /* if the first change */
+			{
+				first = x; /* save first */
+			}
+			last = x; /* save last */
+		}
+	}
+	if (first != 0xFF) /* if changed */
+	{
+		a_ssd1306_mark_dirty(handle, page, first); /* mark first */
+		a_ssd1306_mark_dirty(handle, page, last); /* mark last */
+	}
+}
+
+/**
+ * @brief     copy the masked bits of a column span into one gram page
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] page is the page address
+ * @param[in] left is the first column
+ * @param[in] width is the span width
+ * @param[in] *buf points to the page bytes of the span
+ * @param[in] mask is the bit mask of the page rows
+ * @note      only the changed columns are marked dirty
+ */
+static void a_ssd1306_gram_copy_span(ssd1306_handle_t *handle, uint8_t page,
+				     uint8_t left, uint8_t width,
+				     const uint8_t *buf, uint8_t mask)
+{
+	uint8_t i;
+	uint8_t first;
+	uint8_t last;
+	uint8_t prev;
+	uint8_t value;
+
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+	if (mask == 0xFF) /* if the whole page rows */
+	{
+		first = 0; /* init first */
+		while ((first < width) &&
+		       (SSD1306_GRAM(handle, left + first, page) ==
+			buf[first])) /* skip the same head */
+		{
+			first++; /* next column */
+		}
+		if (first == width) /* if no change */
+		{
+			return; /* nothing to do */
+		}
+		last = width - 1; /* init last */
+		while (SSD1306_GRAM(handle, left + last, page) ==
+		       buf[last]) /* skip the same tail */
+		{
+			last--; /* previous column */
+		}
+		memcpy(&SSD1306_GRAM(handle, left + first, page), &buf[first],
+		       (size_t)(last - first + 1)); /* copy the row */
+		a_ssd1306_mark_dirty(handle, page, left + first); /* mark first */
+		a_ssd1306_mark_dirty(handle, page, left + last); /* mark last */
+
+		return;
+	}
+#endif
+	first = 0xFF; /* no change */
+	last = 0; /* no change */
+	for (i = 0; i < width; i++) /* copy the columns */
+	{
+		prev = SSD1306_GRAM(handle, left + i, page); /* save the old byte */
+		value = (uint8_t)((prev & (uint8_t)(~mask)) |
+				  (buf[i] & mask)); /* merge the bits */
+		if (value != prev) /* check changed */
+		{
+			SSD1306_GRAM(handle, left + i, page) = value; /* set the byte */
+			if (first == 0xFF) /* if the first change */
+			{
+				first = i; /* save first */
+			}
+			last = i; /* save last */
+		}
+	}
+	if (first != 0xFF) /* if changed */
+	{
+		a_ssd1306_mark_dirty(handle, page, left + first); /* mark first */
+		a_ssd1306_mark_dirty(handle, page, left + last); /* mark last */
+	}
+}
+
+/**
+ * @brief     set one point in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the coordinate x
+ * @param[in] y is the coordinate y
+ * @param[in] color is the display color
+ * @note      points outside the screen are dropped
+ */
+static void a_ssd1306_gram_plot(ssd1306_handle_t *handle, int16_t x,
+				int16_t y, uint8_t color)
+{
+	uint8_t prev;
+	uint8_t page;
+
+	if ((x < 0) || (x > 127) || (y < 0) || (y > 63)) /* check the screen */
+	{
+		return; /* outside */
+	}
+	page = (uint8_t)(y / 8); /* get the page */
+	prev = SSD1306_GRAM(handle, x, page); /* save the old byte */
+	if (color != 0) /* if 1 */
+	{
+		SSD1306_GRAM(handle, x, page) |= (uint8_t)(1 << (y % 8)); /* set 1 */
+	} else {
+		SSD1306_GRAM(handle, x, page) &= (uint8_t)(~(1 << (y % 8))); /* set 0 */
+	}
+	if (SSD1306_GRAM(handle, x, page) != prev) /* check changed */
+	{
+		a_ssd1306_mark_dirty(handle, page, (uint8_t)x); /* mark dirty */
+	}
+}
+
+/**
+ * @brief     fill a box in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] color is the display color
+ * @note      the box is clipped to the screen once and filled by page spans
+ */
+static void a_ssd1306_gram_fill_box(ssd1306_handle_t *handle, int16_t left,
+				    int16_t top, int16_t right,
+				    int16_t bottom, uint8_t color)
+{
+	uint8_t page;
+	uint8_t mask;
+
+	left = (left < 0) ? 0 : left; /* clip left */
+	top = (top < 0) ? 0 : top; /* clip top */
+	right = (right > 127) ? 127 : right; /* clip right */
+	bottom = (bottom > 63) ? 63 : bottom; /* clip bottom */
+	if ((left > right) || (top > bottom)) /* check the box */
+	{
+		return; /* outside */
+	}
+	for (page = (uint8_t)(top / 8); page <= bottom / 8; page++) /* fill */
+	{
+		mask = 0xFF; /* full page */
+		if (page == top / 8) /* if the first page */
+		{
+			mask &= (uint8_t)(0xFF << (top % 8)); /* cut the top */
+		}
+		if (page == bottom / 8) /* if the last page */
+		{
+			mask &= (uint8_t)(0xFF >> (7 - (bottom % 8))); /* cut the bottom */
+		}
+		a_ssd1306_gram_fill_span(handle, page, (uint8_t)left,
+					 (uint8_t)right, mask,
+					 color); /* fill the span */
+	}
+}
+
+/**
+ * @brief     draw a horizontal line in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x0 is the left coordinate x
+ * @param[in] x1 is the right coordinate x
+ * @param[in] y is the coordinate y
+ * @param[in] color is the display color
+ * @note      none
+ */
+static void a_ssd1306_gram_hline(ssd1306_handle_t *handle, int16_t x0,
+				 int16_t x1, int16_t y, uint8_t color)
+{
+	a_ssd1306_gram_fill_box(handle, x0, y, x1, y, color); /* one row */
+}
+
+/**
+ * @brief     draw a vertical line in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the coordinate x
+ * @param[in] y0 is the top coordinate y
+ * @param[in] y1 is the bottom coordinate y
+ * @param[in] color is the display color
+ * @note      none
+ */
+static void a_ssd1306_gram_vline(ssd1306_handle_t *handle, int16_t x,
+				 int16_t y0, int16_t y1, uint8_t color)
+{
+	a_ssd1306_gram_fill_box(handle, x, y0, x, y1, color); /* one column */
+}
+
+/**
+ * @brief     draw a circle stretched by a straight middle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the top left corner center x
+ * @param[in] y is the top left corner center y
+ * @param[in] r is the radius
+ * @param[in] dx is the distance to the right corner centers
+ * @param[in] dy is the distance to the bottom corner centers
+ * @param[in] fill is the fill flag
+ * @param[in] color is the display color
+ * @note      dx and dy are 0 for a circle
+ */
+static void a_ssd1306_gram_circle(ssd1306_handle_t *handle, int16_t x,
+				  int16_t y, uint8_t r, int16_t dx, int16_t dy,
+				  uint8_t fill, uint8_t color)
+{
+	int16_t px;
+	int16_t py;
+	int16_t f;
+
+	if (fill != 0) /* if fill */
+	{
+		a_ssd1306_gram_fill_box(handle, x - r, y, x + dx + r, y + dy,
+					color); /* fill the middle */
+	} else {
+		if (dx > 0) /* if straight rows */
+		{
+			a_ssd1306_gram_hline(handle, x, x + dx, y - r,
+					     color); /* top edge */
+			a_ssd1306_gram_hline(handle, x, x + dx, y + dy + r,
+					     color); /* bottom edge */
+		}
+		if (dy > 0) /* if straight columns */
+		{
+			a_ssd1306_gram_vline(handle, x - r, y, y + dy,
+					     color); /* left edge */
+			a_ssd1306_gram_vline(handle, x + dx + r, y, y + dy,
+					     color); /* right edge */
+		}
+	}
+	px = 0; /* init x */
+	py = r; /* init y */
+	f = 1 - (int16_t)r; /* init decision */
+	while (px <= py) /* walk one octant */
+	{
+		if (fill != 0) /* if fill */
+		{
+			a_ssd1306_gram_hline(handle, x - px, x + dx + px, y - py,
+					     color); /* top span */
+			a_ssd1306_gram_hline(handle, x - px, x + dx + px,
+					     y + dy + py, color); /* bottom span */
+			a_ssd1306_gram_hline(handle, x - py, x + dx + py, y - px,
+					     color); /* upper span */
+			a_ssd1306_gram_hline(handle, x - py, x + dx + py,
+					     y + dy + px, color); /* lower span */
+		} else {
+			a_ssd1306_gram_plot(handle, x + dx + px, y + dy + py,
+					    color); /* octant 1 */
+			a_ssd1306_gram_plot(handle, x - px, y + dy + py,
+					    color); /* octant 2 */
+			a_ssd1306_gram_plot(handle, x + dx + px, y - py,
+					    color); /* octant 3 */
+			a_ssd1306_gram_plot(handle, x - px, y - py,
+					    color); /* octant 4 */
+			a_ssd1306_gram_plot(handle, x + dx + py, y + dy + px,
+					    color); /* octant 5 */
+			a_ssd1306_gram_plot(handle, x - py, y + dy + px,
+					    color); /* octant 6 */
+			a_ssd1306_gram_plot(handle, x + dx + py, y - px,
+					    color); /* octant 7 */
+			a_ssd1306_gram_plot(handle, x - py, y - px,
+					    color); /* octant 8 */
+		}
+		if (f >= 0) /* check the decision */
+		{
+			py--; /* step y */
+			f -= 2 * py; /* update */
+		}
+		px++; /* step x */
+		f += 2 * px + 1; /* update */
+	}
+}
+
+/**
+ * @brief     draw or fill a rounded rectangle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] r is the corner radius
+ * @param[in] fill is the fill flag
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 left > right or top > bottom
+ *            - 5 r is invalid
+ * @note      none
+ */
+static uint8_t a_ssd1306_gram_round_rect(ssd1306_handle_t *handle,
+					 int16_t left, int16_t top,
+					 int16_t right, int16_t bottom,
+					 uint8_t r, uint8_t fill, uint8_t color)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((left > right) || (top > bottom)) /* check left right top bottom */
+	{
+		handle->debug_print(
+			"ssd1306: left > right or top > bottom.\n"); /* left > right or top > bottom */
+
+		return 4; /* return error */
+	}
+	if ((2 * (int32_t)r > (int32_t)right - left) ||
+	    (2 * (int32_t)r > (int32_t)bottom - top)) /* check r */
+	{
+		handle->debug_print("ssd1306: r is invalid.\n"); /* r is invalid */
+
+		return 5; /* return error */
+	}
+
+	a_ssd1306_gram_circle(handle, left + r, top + r, r,
+			      (int16_t)(right - left - 2 * r),
+			      (int16_t)(bottom - top - 2 * r), fill,
+			      color); /* draw the rect */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      get the direction vector of an angle
+ * @param[in]  angle is the angle in degree
+ * @param[out] *x points to a q14 x buffer
+ * @param[out] *y points to a q14 y buffer
+ * @note       the angle grows clockwise on the screen
+ */
+static void a_ssd1306_angle_vector(uint16_t angle, int32_t *x, int32_t *y)
+{
+	uint16_t m;
+
+	m = angle % 90; /* get the angle in the quadrant */
+	switch (angle / 90) /* check the quadrant */
+	{
+	case 0: {
+		*x = gsc_ssd1306_sin[90 - m]; /* right */
+		*y = gsc_ssd1306_sin[m]; /* down */
+
+		break;
+	}
+	case 1: {
+		*x = -gsc_ssd1306_sin[m]; /* left */
+		*y = gsc_ssd1306_sin[90 - m]; /* down */
+
+		break;
+	}
+	case 2: {
+		*x = -gsc_ssd1306_sin[90 - m]; /* left */
+		*y = -gsc_ssd1306_sin[m]; /* up */
+
+		break;
+	}
+	default: {
+		*x = gsc_ssd1306_sin[m]; /* right */
+		*y = -gsc_ssd1306_sin[90 - m]; /* up */
+
+		break;
+	}
+	}
+}
+
+/**
+ * @brief     check a point is inside an arc sector
+ * @param[in] x is the point x from the center
+ * @param[in] y is the point y from the center
+ * @param[in] sx is the start vector x
+ * @param[in] sy is the start vector y
+ * @param[in] ex is the end vector x
+ * @param[in] ey is the end vector y
+ * @param[in] major is the flag of a sweep over 180 degree
+ * @return    1 if inside
+ * @note      none
+ */
+static uint8_t a_ssd1306_angle_inside(int32_t x, int32_t y, int32_t sx,
+				      int32_t sy, int32_t ex, int32_t ey,
+				      uint8_t major)
+{
+	if (major == 0) /* if the minor sweep */
+	{
+		return (uint8_t)(((sx * y - sy * x) >= 0) &&
+				 ((x * ey - y * ex) >= 0)); /* between */
+	} else {
+		return (uint8_t)(!(((ex * y - ey * x) > 0) &&
+				   ((x * sy - y * sx) > 0))); /* not in the gap */
+	}
+}
+
+/**
+ * @brief      shift a glyph into page bytes
+ * @param[in]  *glyph points to the glyph columns
+ * @param[in]  size is the char size
+ * @param[in]  shift is the row offset inside the page
+ * @param[in]  mode is the display mode
+ * @param[out] page points to a page bytes buffer
+ * @note       none
+ */
+static void a_ssd1306_glyph_shift(const uint8_t *glyph, uint8_t size,
+				  uint8_t shift, uint8_t mode,
+				  uint8_t page[4][12])
+{
+	uint32_t column;
+	uint32_t rows;
+	uint8_t bytes;
+	uint8_t i;
+	uint8_t k;
+
+	bytes = (uint8_t)((size + 7) / 8); /* get the column bytes */
+	rows = ((uint32_t)1 << size) - 1; /* get the glyph rows */
+	for (i = 0; i < size / 2; i++) /* shift the columns */
+	{
+		column = (uint32_t)glyph[0] |
+			 ((uint32_t)glyph[1] << 8); /* get 2 bytes */
+		if (bytes > 2) /* if 3 bytes */
+		{
+			column |= (uint32_t)glyph[2] << 16; /* get byte 3 */
+		}
+		if (mode == 0) /* if inverted */
+		{
+			column = ~column; /* invert the column */
+		}
+		column = (column & rows) << shift; /* move to y */
+		for (k = 0; k < 4; k++) /* split the pages */
+		{
+			page[k][i] = (uint8_t)column; /* get the byte */
+			column >>= 8; /* next page */
+		}
+		glyph += bytes; /* next column */
+	}
+}
+
+#if (SSD1306_GLYPH_CACHE_SIZE > 0)
+/**
+ * @brief     get the shifted page bytes of a glyph from the cache
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *glyph points to the glyph columns
+ * @param[in] size is the char size
+ * @param[in] shift is the row offset inside the page
+ * @param[in] mode is the display mode
+ * @return    pointer to the page bytes
+ * @note      a miss replaces the entries in turn
+ */
+static const uint8_t (*a_ssd1306_glyph_cache_get(ssd1306_handle_t *handle,
+						 const uint8_t *glyph,
+						 uint8_t size, uint8_t shift,
+						 uint8_t mode))[12]
+{
+	ssd1306_glyph_cache_t *entry;
+	uint8_t i;
+
+	for (i = 0; i < SSD1306_GLYPH_CACHE_SIZE; i++) /* find the glyph */
+	{
+		entry = &handle->glyph_cache[i]; /* get the entry */
+		if ((entry->glyph == glyph) && (entry->shift == shift) &&
+		    (entry->mode == mode)) /* check the key */
+		{
+			return (const uint8_t (*)[12])entry->page; /* hit */
+		}
+	}
+	entry = &handle->glyph_cache[handle->glyph_cache_next]; /* replace */
+	handle->glyph_cache_next++; /* next entry */
+	if (handle->glyph_cache_next >= SSD1306_GLYPH_CACHE_SIZE) /* check the end */
+	{
+		handle->glyph_cache_next = 0; /* wrap around */
+	}
+	a_ssd1306_glyph_shift(glyph, size, shift, mode,
+			      entry->page); /* shift the glyph */
+	entry->glyph = glyph; /* save the glyph */
+	entry->shift = shift; /* save the shift */
+	entry->mode = mode; /* save the mode */
+
+	return (const uint8_t (*)[12])entry->page; /* miss */
+}
+#endif
+
+/**
+ * @brief     draw a char in gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the coordinate x
+ * @param[in] y is the coordinate y
+ * @param[in] *glyph points to the glyph columns
+ * @param[in] size is the char size
+ * @param[in] mode is the display mode
+ * @note      each glyph column is shifted to y and merged a page at a time
+ */
+static void a_ssd1306_gram_show_char(ssd1306_handle_t *handle, uint8_t x,
+				     uint8_t y, const uint8_t *glyph,
+				     uint8_t size, uint8_t mode)
+{
+	const uint8_t (*page_byte)[12];
+	uint32_t rows;
+	uint8_t shift;
+	uint8_t page;
+	uint8_t k;
+#if (SSD1306_GLYPH_CACHE_SIZE == 0)
+	uint8_t buf[4][12];
+#endif
+
+	shift = y % 8; /* get the page shift */
+#if (SSD1306_GLYPH_CACHE_SIZE > 0)
+	page_byte = a_ssd1306_glyph_cache_get(handle, glyph, size, shift,
+					      mode); /* get the cached glyph */
+#else
+	a_ssd1306_glyph_shift(glyph, size, shift, mode,
+			      buf); /* shift the glyph */
+	page_byte = (const uint8_t (*)[12])buf; /* use the buffer */
+#endif
+	rows = (((uint32_t)1 << size) - 1) << shift; /* get the rows */
+	for (k = 0, page = y / 8; rows != 0; k++, page++) /* merge the pages */
+	{
+		a_ssd1306_gram_copy_span(handle, page, x, size / 2,
+					 page_byte[k],
+					 (uint8_t)rows); /* copy the span */
+		rows >>= 8; /* next page */
+	}
+}
+
+/**
+ * @brief     clear the screen
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 clear failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1306_clear(ssd1306_handle_t *handle)
+{
+	uint8_t res;
+#if (SSD1306_STATS == 1)
+	uint32_t start;
+#endif
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_DOUBLE_BUFFER == 1)
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(handle); /* the front may be in flight */
+#endif
+	memset(handle->buffer, 0x00, sizeof(handle->buffer)); /* set black */
+#else
+	memset(&handle->frame[1], 0x00, SSD1306_GRAM_SIZE); /* set black */
+#endif
+#if (SSD1306_STATS == 1)
+	start = a_ssd1306_stats_time(handle); /* get the start time */
+#endif
+	res = a_ssd1306_write_gram(handle); /* write gram */
+#if (SSD1306_STATS == 1)
+	a_ssd1306_stats_flush(handle, start); /* count flush */
+#endif
+	if (res != 0) /* check the result */
+	{
+		handle->debug_print(
+			"ssd1306: write byte failed.\n"); /* write byte failed */
+
+		return 1; /* return error */
+	}
+	a_ssd1306_set_dirty_all(handle, 0); /* clear dirty */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     update the gram data
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ssd1306_gram_update(ssd1306_handle_t *handle)
+{
+	uint8_t res;
+#if (SSD1306_STATS == 1)
+	uint32_t start;
+#endif
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_STATS == 1)
+	start = a_ssd1306_stats_time(handle); /* get the start time */
+#endif
+	res = a_ssd1306_write_gram(handle); /* write gram */
+#if (SSD1306_STATS == 1)
+	a_ssd1306_stats_flush(handle, start); /* count flush */
+#endif
+	if (res != 0) /* check the result */
+	{
+		handle->debug_print(
+			"ssd1306: write byte failed.\n"); /* write byte failed */
+
+		return 1; /* return error */
+	}
+	a_ssd1306_set_dirty_all(handle, 0); /* clear dirty */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     write the dirty ranges of the gram data
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_update_dirty(ssd1306_handle_t *handle)
+{
+	uint8_t i;
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* a failed asynchronous flush marks the gram dirty */
+#endif
+	a_ssd1306_spi_batch_begin(handle); /* open the spi batch */
+	for (i = 0; i < 8; i++) /* check 8 page */
+	{
+		if (handle->dirty_start[i] > handle->dirty_end[i]) /* check clean */
+		{
+			continue; /* skip the page */
+		}
+		if (a_ssd1306_write_page(handle, i, handle->dirty_start[i],
+					 handle->dirty_end[i]) !=
+		    0) /* write page */
+		{
+			(void)a_ssd1306_spi_batch_end(handle); /* close */
+			handle->debug_print(
+				"ssd1306: write byte failed.\n"); /* write byte failed */
+
+			return 1; /* return error */
+		}
+		handle->dirty_start[i] = 0xFF; /* set clean start */
+		handle->dirty_end[i] = 0x00; /* set clean end */
+	}
+	if (a_ssd1306_spi_batch_end(handle) != 0) /* submit */
+	{
+		handle->debug_print(
+			"ssd1306: write byte failed.\n"); /* write byte failed */
+
+		return 1; /* return error */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     update the dirty ranges of the gram data
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      only the columns changed since the last update are sent
+ */
+uint8_t ssd1306_gram_update_dirty(ssd1306_handle_t *handle)
+{
+	uint8_t res;
+#if (SSD1306_STATS == 1)
+	uint32_t start;
+#endif
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_STATS == 1)
+	start = a_ssd1306_stats_time(handle); /* get the start time */
+#endif
+	res = a_ssd1306_update_dirty(handle); /* write the dirty ranges */
+#if (SSD1306_STATS == 1)
+	a_ssd1306_stats_flush(handle, start); /* count flush */
+#endif
+
+	return res; /* return the result */
+}
+
+#if (SSD1306_SHADOW_BUFFER == 1)
+/**
+ * @brief     get the cost of a new diff run
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    unchanged bytes that cost as much as a new run
+ * @note      a gap between two runs is sent as data if it is not longer
+ */
+static uint8_t a_ssd1306_diff_run_cost(ssd1306_handle_t *handle)
+{
+	if (handle->iic_spi == SSD1306_INTERFACE_SPI_3WIRE) /* if 3-wire spi */
+	{
+		return SSD1306_DIFF_SPI_3WIRE_RUN_COST; /* 3-wire spi cost */
+	}
+	if (handle->iic_spi != SSD1306_INTERFACE_IIC) /* if spi */
+	{
+		return SSD1306_DIFF_SPI_RUN_COST; /* spi cost */
+	}
+	if (handle->flush_mode == SSD1306_FLUSH_MODE_BYTE) /* if byte mode */
+	{
+		return SSD1306_DIFF_IIC_BYTE_RUN_COST; /* byte cost */
+	}
+	if (handle->iic_transport ==
+	    SSD1306_IIC_TRANSPORT_CONTINUATION) /* if continuation */
+	{
+		return SSD1306_DIFF_IIC_CONTINUATION_RUN_COST; /* continuation cost */
+	}
+
+	return SSD1306_DIFF_IIC_RUN_COST; /* iic cost */
+}
+#endif
+
+/**
+ * @brief     write the gram data changed since the shadow buffer
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_update_diff(ssd1306_handle_t *handle)
+{
+#if (SSD1306_SHADOW_BUFFER == 1)
+	uint8_t mask[128];
+	uint8_t cost;
+	uint8_t start;
+	uint8_t end;
+	uint8_t i;
+	uint8_t j;
+	uint64_t a;
+	uint64_t b;
+#endif
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* a failed asynchronous flush invalidates the shadow */
+#endif
+#if (SSD1306_SHADOW_BUFFER == 1)
+	if (handle->shadow_valid != 1) /* check the shadow */
+	{
+		if (a_ssd1306_write_gram(handle) != 0) /* write gram */
+		{
+			handle->debug_print(
+				"ssd1306: write byte failed.\n"); /* write byte failed */
+
+			return 1; /* return error */
+		}
+		a_ssd1306_set_dirty_all(handle, 0); /* clear dirty */
+
+		return 0; /* success return 0 */
+	}
+
+	memset(mask, 0, sizeof(mask)); /* clear the mask */
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+	for (j = 0; j < 8; j++) /* compare 8 page */
+	{
+		for (i = 0; i < 128; i += 8) /* 8 column a word */
+		{
+			memcpy(&a, &SSD1306_FRONT(handle, i, j),
+			       8); /* 8 column of the page */
+			memcpy(&b, &handle->shadow[j][i], 8); /* 8 column of the shadow */
+			if (a == b) /* check changed */
+			{
+				continue; /* skip the word */
+			}
+			for (start = i; start < i + 8; start++) /* check 8 column */
+			{
+				if (SSD1306_FRONT(handle, start, j) !=
+				    handle->shadow[j][start]) /* check */
+				{
+					mask[start] |= (uint8_t)(1 << j); /* mark */
+				}
+			}
+		}
+	}
+#else
+	for (i = 0; i < 128; i++) /* compare 128 column */
+	{
+		memcpy(&a, &SSD1306_FRONT(handle, i, 0),
+		       8); /* 8 page of the column */
+		memcpy(&b, handle->shadow[i], 8); /* 8 page of the shadow */
+		if (a == b) /* check changed */
+		{
+			continue; /* skip the column */
+		}
+		for (j = 0; j < 8; j++) /* check 8 page */
+		{
+			if (SSD1306_FRONT(handle, i, j) !=
+			    handle->shadow[i][j]) /* check */
+			{
+				mask[i] |= (uint8_t)(1 << j); /* mark the page */
+			}
+		}
+	}
+#endif
+	cost = a_ssd1306_diff_run_cost(handle); /* get the run cost */
+	a_ssd1306_spi_batch_begin(handle); /* open the spi batch */
+	for (j = 0; j < 8; j++) /* run 8 page */
+	{
+		start = 0xFF; /* no run */
+		end = 0; /* init 0 */
+		for (i = 0; i < 128; i++) /* find the runs */
+		{
+			if ((mask[i] & (1 << j)) == 0) /* check changed */
+			{
+				continue; /* skip the column */
+			}
+			if (start == 0xFF) /* if no run */
+			{
+				start = i; /* start a run */
+			} else if ((i - end - 1) >
+				   cost) /* the gap costs more than a new run */
+			{
+				if (a_ssd1306_write_page(handle, j, start, end) !=
+				    0) /* write the run */
+				{
+					(void)a_ssd1306_spi_batch_end(
+						handle); /* close */
+					handle->debug_print(
+						"ssd1306: write byte failed.\n"); /* write byte failed */
+
+					return 1; /* return error */
+				}
+				start = i; /* start a run */
+			}
+			end = i; /* extend the run */
+		}
+		if (start != 0xFF) /* check the last run */
+		{
+			if (a_ssd1306_write_page(handle, j, start, end) !=
+			    0) /* write the run */
+			{
+				(void)a_ssd1306_spi_batch_end(handle); /* close */
+				handle->debug_print(
+					"ssd1306: write byte failed.\n"); /* write byte failed */
+
+				return 1; /* return error */
+			}
+		}
+	}
+	if (a_ssd1306_spi_batch_end(handle) != 0) /* submit */
+	{
+		handle->debug_print(
+			"ssd1306: write byte failed.\n"); /* write byte failed */
+
+		return 1; /* return error */
+	}
+	a_ssd1306_set_dirty_all(handle, 0); /* clear dirty */
+
+	return 0; /* success return 0 */
+#else
+	return a_ssd1306_update_dirty(handle); /* update dirty */
+#endif
+}
+
+/**
+ * @brief     update the gram data by comparing it with the shadow buffer
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      only the changed column runs are sent and the whole gram is sent
+ *            while the shadow is not valid, runs closer than the cost of new
+ *            addressing on the current interface, transport and flush mode
+ *            are merged, without SSD1306_SHADOW_BUFFER it works as
+ *            ssd1306_gram_update_dirty
+ */
+uint8_t ssd1306_gram_update_diff(ssd1306_handle_t *handle)
+{
+	uint8_t res;
+#if (SSD1306_STATS == 1)
+	uint32_t start;
+#endif
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_STATS == 1)
+	start = a_ssd1306_stats_time(handle); /* get the start time */
+#endif
+	res = a_ssd1306_update_diff(handle); /* write the changed runs */
+#if (SSD1306_STATS == 1)
+	a_ssd1306_stats_flush(handle, start); /* count flush */
+#endif
+
+	return res; /* return the result */
+}
+
+/**
+ * @brief     start an asynchronous gram update
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *callback points to a completion callback, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update async failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async is not supported
+ *            - 5 the last update is still running
+ * @note      the gram is copied before this function returns, so drawing can
+ *            go on while the transfer runs, with SSD1306_DOUBLE_BUFFER the
+ *            front buffer is sent without a copy, the result and the callback
+ *            are reported only by ssd1306_gram_update_async_poll or
+ *            ssd1306_gram_update_async_wait, other driver calls wait for the
+ *            transfer and keep the result, a result that is not reported
+ *            before the next update starts is dropped
+ */
+uint8_t ssd1306_gram_update_async(ssd1306_handle_t *handle,
+				  void (*callback)(uint8_t res))
+{
+#if (SSD1306_ASYNC_FLUSH == 1)
+	uint8_t *data;
+	uint8_t len;
+	uint8_t busy;
+	uint8_t res;
+#endif
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	if ((handle->async_write == NULL) || (handle->async_poll == NULL) ||
+	    (handle->iic_spi ==
+	     SSD1306_INTERFACE_SPI_3WIRE)) /* check the hooks and interface */
+	{
+		handle->debug_print(
+			"ssd1306: async is not supported.\n"); /* async is not supported */
+
+		return 4; /* return error */
+	}
+	a_ssd1306_async_check(handle, &busy); /* check the last update */
+	if (busy != 0) /* check busy */
+	{
+		return 5; /* return error */
+	}
+	handle->async_done = 0; /* drop the unreported result */
+	handle->batch_enable = 0; /* stop the batch */
+	if (a_ssd1306_batch_flush(handle) != 0) /* send the queued commands */
+	{
+		handle->debug_print(
+			"ssd1306: write command failed.\n"); /* write command failed */
+
+		return 1; /* return error */
+	}
+
+	len = a_ssd1306_frame_command(handle,
+				      (uint8_t *)handle->async_cmd); /* build */
+#if (SSD1306_DOUBLE_BUFFER == 1)
+	data = SSD1306_FRONT_BUFFER(handle); /* the front stays until the swap */
+#else
+	memcpy(&handle->async_buf[1], &handle->frame[1],
+	       SSD1306_GRAM_SIZE); /* snapshot the gram */
+	data = &handle->async_buf[1]; /* send the snapshot after the headroom */
+#endif
+	handle->async_callback = callback; /* save the callback */
+	handle->async_busy = 1; /* set busy */
+	handle->dc_level = 0xFF; /* the transfer drives the level itself */
+#if (SSD1306_STATS == 1)
+	handle->async_start = a_ssd1306_stats_time(handle); /* get the start time */
+#endif
+	res = handle->async_write(handle->iic_spi, handle->iic_addr,
+				  (uint8_t *)handle->async_cmd, len, data,
+				  SSD1306_GRAM_SIZE); /* start the transfer */
+	SSD1306_STATS_BUS(handle, SSD1306_DATA,
+			  (uint16_t)(len + SSD1306_GRAM_SIZE), res);
+	SSD1306_TRACE(handle, SSD1306_DATA, handle->async_cmd, len,
+		      (uint16_t)(len + SSD1306_GRAM_SIZE), res);
+	if (res != 0) /* check the result */
+	{
+		handle->async_busy = 0; /* set idle */
+		handle->debug_print(
+			"ssd1306: async write failed.\n"); /* async write failed */
+
+		return 1; /* return error */
+	}
+	handle->addressing_mode =
+		SSD1306_FRAME_ADDRESSING_MODE; /* save addressing mode */
+#if (SSD1306_SHADOW_BUFFER == 1)
+	memcpy(handle->shadow, data, SSD1306_GRAM_SIZE); /* update the shadow */
+	handle->shadow_valid = 1; /* the shadow matches the snapshot */
+#endif
+	a_ssd1306_set_dirty_all(handle, 0); /* clear dirty */
+
+	return 0; /* success return 0 */
+#else
+	(void)callback; /* no async */
+	handle->debug_print(
+		"ssd1306: async is not supported.\n"); /* async is not supported */
+
+	return 4; /* return error */
+#endif
+}
+
+/**
+ * @brief      poll the asynchronous gram update
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *busy points to a busy flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the finished transfer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the callback runs here once the transfer is found finished, also
+ *             when another driver call waited for it before
+ */
+uint8_t ssd1306_gram_update_async_poll(ssd1306_handle_t *handle, uint8_t *busy)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_check(handle, busy); /* check */
+	if (*busy != 0) /* check busy */
+	{
+		return 0; /* success return 0 */
+	}
+
+	return a_ssd1306_async_report(handle); /* report the result */
+#else
+	*busy = 0; /* never busy */
+
+	return 0; /* success return 0 */
+#endif
+}
+
+/**
+ * @brief     wait for the asynchronous gram update
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 the finished transfer failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback runs here once the transfer is over
+ */
+uint8_t ssd1306_gram_update_async_wait(ssd1306_handle_t *handle)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(handle); /* wait */
+
+	return a_ssd1306_async_report(handle); /* report the result */
+#else
+	return 0; /* success return 0 */
+#endif
+}
+
+/**
+ * @brief     swap the front and back buffers
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 double buffer is not supported
+ *            - 5 an async update is still reading the front buffer
+ * @note      the drawn back buffer becomes the front buffer for the next
+ *            update and drawing goes on in the old front buffer, so each
+ *            frame is drawn in full or compared with the shadow buffer
+ */
+uint8_t ssd1306_swap_buffers(ssd1306_handle_t *handle)
+{
+#if (SSD1306_DOUBLE_BUFFER == 1)
+#if (SSD1306_ASYNC_FLUSH == 1)
+	uint8_t busy;
+#endif
+#endif
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+#if (SSD1306_DOUBLE_BUFFER == 1)
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_check(handle, &busy); /* check the last update */
+	if (busy != 0) /* check busy */
+	{
+		return 5; /* return error */
+	}
+#endif
+	handle->front ^= 1; /* publish the back and draw into the old front */
+	a_ssd1306_set_dirty_all(
+		handle, 1); /* the ranges do not follow the buffer swap */
+
+	return 0; /* success return 0 */
+#else
+	handle->debug_print(
+		"ssd1306: double buffer is not supported.\n"); /* double buffer is not supported */
+
+	return 4; /* return error */
+#endif
+}
+
+#if (SSD1306_STATS == 1)
+/**
+ * @brief      get the stats
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *stats points to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the flush latency is only counted with a linked timestamp_us,
+ *             an async flush is timed from its start to its completion
+ */
+uint8_t ssd1306_get_stats(ssd1306_handle_t *handle, ssd1306_stats_t *stats)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	memcpy(stats, &handle->stats, sizeof(ssd1306_stats_t)); /* copy the stats */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ssd1306_init resets the stats too
+ */
+uint8_t ssd1306_reset_stats(ssd1306_handle_t *handle)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	memset(&handle->stats, 0, sizeof(ssd1306_stats_t)); /* clear the stats */
+
+	return 0; /* success return 0 */
+}
+#endif
+
+#if (SSD1306_TRACE_SIZE > 0)
+/**
+ * @brief         get the trace
+ * @param[in]     *handle points to an ssd1306 handle structure
+ * @param[out]    *entry points to a trace entry buffer
+ * @param[in,out] *num points to the buffer entry number and returns the copied entry number
+ * @param[out]    *count points to a buffer of all recorded calls since the last clear
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the newest entries are copied oldest first, entries overwritten by the driver
+ *                while they are copied are dropped, so it can run beside the driver without a lock
+ */
+uint8_t ssd1306_get_trace(ssd1306_handle_t *handle,
+			  ssd1306_trace_entry_t *entry, uint16_t *num,
+			  uint32_t *count)
+{
+	uint32_t start;
+	uint32_t end;
+	uint32_t after;
+	uint32_t drop;
+	uint32_t i;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	end = handle->trace_count; /* get the published entries */
+	SSD1306_TRACE_ACQUIRE(); /* the count before the entries */
+	start = (end > SSD1306_TRACE_SIZE) ? (end - SSD1306_TRACE_SIZE) :
+					     0; /* the oldest kept entry */
+	if ((end - start) > *num) /* check the buffer */
+	{
+		start = end - *num; /* keep the newest */
+	}
+	for (i = start; i != end; i++) /* copy the entries */
+	{
+		memcpy(&entry[i - start], &handle->trace[i % SSD1306_TRACE_SIZE],
+		       sizeof(ssd1306_trace_entry_t)); /* copy the entry */
+	}
+	SSD1306_TRACE_ACQUIRE(); /* the entries before the count */
+	after = handle->trace_count; /* snapshot the count once */
+	drop = 0; /* init 0 */
+	if ((after - start) >=
+	    SSD1306_TRACE_SIZE) /* check the overwritten entries */
+	{
+		drop = after - start - SSD1306_TRACE_SIZE +
+		       1; /* the oldest slots were written again */
+		if (drop > (end - start)) /* check all */
+		{
+			drop = end - start; /* drop all */
+		}
+		memmove(&entry[0], &entry[drop],
+			(end - start - drop) *
+				sizeof(ssd1306_trace_entry_t)); /* drop them */
+	}
+	*num = (uint16_t)(end - start - drop); /* set the number */
+	*count = end; /* set the count */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     print the trace
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the entries are printed oldest first through debug_print
+ */
+uint8_t ssd1306_print_trace(ssd1306_handle_t *handle)
+{
+	ssd1306_trace_entry_t entry;
+	uint32_t start;
+	uint32_t end;
+	uint32_t i;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	end = handle->trace_count; /* get the published entries */
+	SSD1306_TRACE_ACQUIRE(); /* the count before the entries */
+	start = (end > SSD1306_TRACE_SIZE) ? (end - SSD1306_TRACE_SIZE) :
+					     0; /* the oldest kept entry */
+	handle->debug_print("ssd1306: trace keeps %u of %u calls.\n",
+			    (unsigned int)(end - start),
+			    (unsigned int)end); /* print the count */
+	for (i = start; i != end; i++) /* print the entries */
+	{
+		memcpy(&entry, &handle->trace[i % SSD1306_TRACE_SIZE],
+		       sizeof(ssd1306_trace_entry_t)); /* copy the entry */
+		SSD1306_TRACE_ACQUIRE(); /* the entry before the count */
+		if ((handle->trace_count - i) >=
+		    SSD1306_TRACE_SIZE) /* check overwritten */
+		{
+			continue; /* skip the entry */
+		}
+		handle->debug_print(
+			"ssd1306: trace %u at %uus %s len %u res %u %02X %02X %02X %02X.\n",
+			(unsigned int)i, (unsigned int)entry.timestamp_us,
+			(entry.kind != 0) ? "data" : "cmd",
+			(unsigned int)entry.len, (unsigned int)entry.res,
+			entry.head[0], entry.head[1], entry.head[2],
+			entry.head[3]); /* print the entry */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     clear the trace
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ssd1306_init clears the trace too
+ */
+uint8_t ssd1306_clear_trace(ssd1306_handle_t *handle)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	handle->trace_count = 0; /* clear the trace */
+
+	return 0; /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     write a point
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the coordinate x
+ * @param[in] y is the coordinate y
+ * @param[in] data is the write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write point failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 x or y is invalid
+ * @note      none
+ */
+uint8_t ssd1306_write_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
+			    uint8_t data)
+{
+	uint8_t pos;
+	uint8_t bx;
+	uint8_t temp = 0;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((x > 127) || (y > 63)) /* check x, y */
+	{
+		handle->debug_print(
+			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+
+		return 4; /* return error */
+	}
+
+	pos = y / 8; /* get y page */
+	bx = y % 8; /* get y point */
+	temp = 1 << bx; /* set data */
+#if ((SSD1306_DOUBLE_BUFFER == 1) && (SSD1306_ASYNC_FLUSH == 1))
+	a_ssd1306_async_wait(handle); /* the front may be in flight */
+#endif
+	if (data != 0) /* check the data */
+	{
+		SSD1306_GRAM(handle, x, pos) |= temp; /* set 1 */
+#if (SSD1306_DOUBLE_BUFFER == 1)
+		SSD1306_FRONT(handle, x, pos) |= temp; /* set 1 on the front */
+#endif
+	} else {
+		SSD1306_GRAM(handle, x, pos) &= ~temp; /* set 0 */
+#if (SSD1306_DOUBLE_BUFFER == 1)
+		SSD1306_FRONT(handle, x, pos) &= ~temp; /* set 0 on the front */
+#endif
+	}
+	if (a_ssd1306_write_page(handle, pos, x, x) != 0) /* write the column */
+	{
+		handle->debug_print(
+			"ssd1306: write byte failed.\n"); /* write byte failed */
+
+		return 1; /* return error */
+	} else {
+		return 0; /* success return 0 */
+	}
+}
+
+/**
+ * @brief     write a group of points
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *point points to a point buffer
+ * @param[in] num is the point number
+ * @param[in] data is the write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write points failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 point is NULL or num is 0
+ *            - 5 x or y is invalid
+ * @note      the points are grouped by page and column and each run of
+ *            adjacent columns is sent with one addressing sequence and one
+ *            data burst
+ */
+uint8_t ssd1306_write_points(ssd1306_handle_t *handle,
+			     const ssd1306_point_t *point, uint16_t num,
+			     uint8_t data)
+{
+	uint8_t column[8][16];
+	uint8_t page;
+	uint8_t start;
+	uint8_t temp;
+	uint8_t x;
+	uint16_t i;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((point == NULL) || (num == 0)) /* check point */
+	{
+		handle->debug_print(
+			"ssd1306: point is invalid.\n"); /* point is invalid */
+
+		return 4; /* return error */
+	}
+	for (i = 0; i < num; i++) /* check all points first */
+	{
+		if ((point[i].x < 0) || (point[i].x > 127) || (point[i].y < 0) ||
+		    (point[i].y > 63)) /* check x, y */
+		{
+			handle->debug_print(
+				"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+
+			return 5; /* return error */
+		}
+	}
+
+	memset(column, 0, sizeof(column)); /* clear the column map */
+#if ((SSD1306_DOUBLE_BUFFER == 1) && (SSD1306_ASYNC_FLUSH == 1))
+	a_ssd1306_async_wait(handle); /* the front may be in flight */
+#endif
+	for (i = 0; i < num; i++) /* update the gram */
+	{
+		x = (uint8_t)point[i].x; /* get x */
+		page = (uint8_t)(point[i].y >> 3); /* get y page */
+		temp = (uint8_t)(1 << (point[i].y & 0x07)); /* get y bit */
+		if (data != 0) /* check the data */
+		{
+			SSD1306_GRAM(handle, x, page) |= temp; /* set 1 */
+#if (SSD1306_DOUBLE_BUFFER == 1)
+			SSD1306_FRONT(handle, x, page) |= temp; /* set 1 on the front */
+#endif
+		} else {
+			SSD1306_GRAM(handle, x, page) &= ~temp; /* set 0 */
+#if (SSD1306_DOUBLE_BUFFER == 1)
+			SSD1306_FRONT(handle, x, page) &= ~temp; /* set 0 on the front */
+#endif
+		}
+		column[page][x >> 3] |= (uint8_t)(1 << (x & 0x07)); /* mark column */
+	}
+	for (page = 0; page < 8; page++) /* write each page */
+	{
+		x = 0; /* init 0 */
+		while (x < 128) /* find the runs */
+		{
+			if (column[page][x >> 3] == 0) /* skip 8 empty columns */
+			{
+				x = (uint8_t)((x | 0x07) + 1); /* next group */
+
+				continue; /* continue */
+			}
+			if ((column[page][x >> 3] & (1 << (x & 0x07))) == 0) /* skip */
+			{
+				x++; /* next column */
+
+				continue; /* continue */
+			}
+			start = x; /* run start */
+			while ((x < 128) &&
+			       ((column[page][x >> 3] & (1 << (x & 0x07))) !=
+				0)) /* find the run end */
+			{
+				x++; /* next column */
+			}
+			if (a_ssd1306_write_page(handle, page, start,
+						 (uint8_t)(x - 1)) !=
+			    0) /* write the run */
+			{
+				handle->debug_print(
+					"ssd1306: write byte failed.\n"); /* write byte failed */
+
+				return 1; /* return error */
+			}
+		}
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      read a point
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[in]  x is the coordinate x
+ * @param[in]  y is the coordinate y
+ * @param[out] *data points to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read point failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 x or y is invalid
+ * @note       none
+ */
+uint8_t ssd1306_read_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
+			   uint8_t *data)
+{
+	uint8_t pos;
+	uint8_t bx;
+	uint8_t temp = 0;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((x > 127) || (y > 63)) /* check x, y */
+	{
+		handle->debug_print(
+			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+
+		return 4; /* return error */
+	}
+
+	pos = y / 8; /* get y page */
+	bx = y % 8; /* get y point */
+	temp = 1 << bx; /* set data */
+	if ((SSD1306_GRAM(handle, x, pos) & temp) != 0) /* get data */
+	{
+		*data = 1; /* set 1 */
+	} else {
+		*data = 0; /* set 0 */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     write a point in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the coordinate x
+ * @param[in] y is the coordinate y
+ * @param[in] data is the write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram write point failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 x or y is invalid
+ * @note      none
+ */
+uint8_t ssd1306_gram_write_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
+				 uint8_t data)
+{
+	uint8_t pos;
+	uint8_t bx;
+	uint8_t temp = 0;
+	uint8_t prev;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((x > 127) || (y > 63)) /* check x, y */
+	{
+		handle->debug_print(
+			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+
+		return 4; /* return error */
+	}
+
+	pos = y / 8; /* get y page */
+	bx = y % 8; /* get y point */
+	temp = 1 << bx; /* set data */
+	prev = SSD1306_GRAM(handle, x, pos); /* save the old byte */
+	if (data != 0) /* if 1 */
+	{
+		SSD1306_GRAM(handle, x, pos) |= temp; /* set 1 */
+	} else {
+		SSD1306_GRAM(handle, x, pos) &= ~temp; /* set 0 */
+	}
+	if (SSD1306_GRAM(handle, x, pos) != prev) /* check changed */
+	{
+		a_ssd1306_mark_dirty(handle, pos, x); /* mark dirty */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      read a point from the gram
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[in]  x is the coordinate x
+ * @param[in]  y is the coordinate y
+ * @param[out] *data points to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 gram read point failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 x or y is invalid
+ * @note       none
+ */
+uint8_t ssd1306_gram_read_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y,
+				uint8_t *data)
+{
+	uint8_t pos;
+	uint8_t bx;
+	uint8_t temp = 0;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((x > 127) || (y > 63)) /* check x, y */
+	{
+		handle->debug_print(
+			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+
+		return 4; /* return error */
+	}
+
+	pos = y / 8; /* get y page */
+	bx = y % 8; /* get y point */
+	temp = 1 << bx; /* set data */
+	if ((SSD1306_GRAM(handle, x, pos) & temp) != 0) /* get data */
+	{
+		*data = 1; /* set 1 */
+	} else {
+		*data = 0; /* set 0 */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     draw a string in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the coordinate x
+ * @param[in] y is the coordinate y
+ * @param[in] *str points to a write string address
+ * @param[in] len is the length of the string
+ * @param[in] color is the display color
+ * @param[in] font is the display font size
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram write string failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 x or y is invalid
+ * @note      none
+ */
+uint8_t ssd1306_gram_write_string(ssd1306_handle_t *handle, uint8_t x,
+				  uint8_t y, char *str, uint16_t len,
+				  uint8_t color, ssd1306_font_t font)
+{
+	const uint8_t *table;
+	uint8_t glyph_size;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((x > 127) || (y > 63)) /* check x, y */
+	{
+		handle->debug_print(
+			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+
+		return 4; /* return error */
+	}
+
+	if (font == SSD1306_FONT_12) /* if size 12 */
+	{
+		table = &gsc_ssd1306_ascii_1206[0][0]; /* ascii 1206 */
+	} else if (font == SSD1306_FONT_16) /* if size 16 */
+	{
+		table = &gsc_ssd1306_ascii_1608[0][0]; /* ascii 1608 */
+	} else if (font == SSD1306_FONT_24) /* if size 24 */
+	{
+		table = &gsc_ssd1306_ascii_2412[0][0]; /* ascii 2412 */
+	} else {
+		table = NULL; /* no table */
+	}
+	glyph_size = (uint8_t)(((font + 7) / 8) * (font / 2)); /* get size */
+
+	while ((len != 0) && (*str <= '~') &&
+	       (*str >= ' ')) /* write all string */
+	{
+		if (x > (127 - (font / 2))) /* check x point */
+		{
+			x = 0; /* set x */
+			y += (uint8_t)font; /* set next row */
+		}
+		if (y > (63 - font)) /* check y pont */
+		{
+			y = x = 0; /* reset to 0,0 */
+		}
+		if (table == NULL) /* check the font */
+		{
+			handle->debug_print(
+				"ssd1306: font is invalid.\n"); /* font is invalid */
+
+			return 1; /* return error */
+		}
+		a_ssd1306_gram_show_char(
+			handle, x, y,
+			&table[(uint16_t)(*str - ' ') * glyph_size], font,
+			color); /* show a char */
+		x += (uint8_t)(font / 2); /* x + font/2 */
+		str++; /* str address++ */
+		len--; /* str length-- */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     fill a rectangle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram fill rect failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 left or top is invalid
+ *            - 5 right or bottom is invalid
+ *            - 6 left > right or top > bottom
+ * @note      each page is filled as one masked column span
+ */
+uint8_t ssd1306_gram_fill_rect(ssd1306_handle_t *handle, uint8_t left,
+			       uint8_t top, uint8_t right, uint8_t bottom,
+			       uint8_t color)
+{
+	uint8_t page;
+	uint8_t page_start;
+	uint8_t page_end;
+	uint8_t mask;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((left > 127) || (top > 63)) /* check left top */
+	{
+		handle->debug_print(
+			"ssd1306: left or top is invalid.\n"); /* left or top is invalid */
+
+		return 4; /* return error */
+	}
+	if ((right > 127) || (bottom > 63)) /* check right bottom */
+	{
+		handle->debug_print(
+			"ssd1306: right or bottom is invalid.\n"); /* right or bottom is invalid */
+
+		return 5; /* return error */
+	}
+	if ((left > right) || (top > bottom)) /* check left right top bottom */
+	{
+		handle->debug_print(
+			"ssd1306: left > right or top > bottom.\n"); /* left > right or top > bottom */
+
+		return 6; /* return error */
+	}
+
+	page_start = top / 8; /* get the first page */
+	page_end = bottom / 8; /* get the last page */
+	for (page = page_start; page <= page_end; page++) /* fill the pages */
+	{
+		mask = 0xFF; /* full page */
+		if (page == page_start) /* if the first page */
+		{
+			mask &= (uint8_t)(0xFF << (top % 8)); /* cut the top */
+		}
+		if (page == page_end) /* if the last page */
+		{
+			mask &= (uint8_t)(0xFF >> (7 - (bottom % 8))); /* cut the bottom */
+		}
+		a_ssd1306_gram_fill_span(handle, page, left, right, mask,
+					 color); /* fill the span */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     draw a picture in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] *img points to an image buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram draw picture failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 left or top is invalid
+ *            - 5 right or bottom is invalid
+ *            - 6 left > right or top > bottom
+ * @note      none
+ */
+uint8_t ssd1306_gram_draw_picture(ssd1306_handle_t *handle, uint8_t left,
+				  uint8_t top, uint8_t right, uint8_t bottom,
+				  uint8_t *img)
+{
+	uint8_t buf[128];
+	uint8_t x, y;
+	uint8_t page;
+	uint8_t row;
+	uint8_t mask;
+	uint8_t column;
+	uint8_t height;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((left > 127) || (top > 63)) /* check left top */
+	{
+		handle->debug_print(
+			"ssd1306: left or top is invalid.\n"); /* left or top is invalid */
+
+		return 4; /* return error */
+	}
+	if ((right > 127) || (bottom > 63)) /* check right bottom */
+	{
+		handle->debug_print(
+			"ssd1306: right or bottom is invalid.\n"); /* right or bottom is invalid */
+
+		return 5; /* return error */
+	}
+	if ((left > right) || (top > bottom)) /* check left right top bottom */
+	{
+		handle->debug_print(
+			"ssd1306: left > right or top > bottom.\n"); /* left > right or top > bottom */
+
+		return 6; /* return error */
+	}
+
+	height = bottom - top + 1; /* get the height */
+	for (page = top / 8; page <= bottom / 8; page++) /* draw the pages */
+	{
+		mask = 0x00; /* no row */
+		for (x = left; x <= right; x++) /* build the columns */
+		{
+			column = 0x00; /* init 0 */
+			for (y = 0; y < 8; y++) /* build 8 rows */
+			{
+				row = (uint8_t)(page * 8 + y); /* get the row */
+				if ((row < top) || (row > bottom)) /* check the row */
+				{
+					continue; /* outside the picture */
+				}
+				mask |= (uint8_t)(1 << y); /* set the row */
+				if (img[(x - left) * height + (row - top)] !=
+				    0) /* check the pixel */
+				{
+					column |= (uint8_t)(1 << y); /* set 1 */
+				}
+			}
+			buf[x - left] = column; /* save the column */
+		}
+		a_ssd1306_gram_copy_span(handle, page, left,
+					 (uint8_t)(right - left + 1),
+					 (uint8_t *)buf, mask); /* copy the span */
+	}
+
+	return 0; /* succeed return 0 */
+}
+
+/**
+ * @brief     draw a packed 1bpp bitmap in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the left coordinate x
+ * @param[in] y is the top coordinate y
+ * @param[in] width is the bitmap width
+ * @param[in] height is the bitmap height
+ * @param[in] *bitmap points to a bitmap buffer
+ * @param[in] format is the bitmap format
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram draw bitmap failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 x or y is invalid
+ *            - 5 width or height is invalid
+ *            - 6 format is invalid
+ * @note      a page-major bitmap at a page aligned y is copied row by row
+ */
+uint8_t ssd1306_gram_draw_bitmap(ssd1306_handle_t *handle, uint8_t x,
+				 uint8_t y, uint8_t width, uint8_t height,
+				 const uint8_t *bitmap,
+				 ssd1306_bitmap_format_t format)
+{
+	uint8_t buf[128];
+	const uint8_t *src;
+	uint8_t page;
+	uint8_t shift;
+	uint8_t mask;
+	uint8_t bottom;
+	uint8_t stride;
+	uint8_t row;
+	uint8_t sy;
+	uint8_t i;
+	int16_t k;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((x > 127) || (y > 63)) /* check x, y */
+	{
+		handle->debug_print(
+			"ssd1306: x or y is invalid.\n"); /* x or y is invalid */
+
+		return 4; /* return error */
+	}
+	if ((width == 0) || (height == 0) || (width > 128 - x) ||
+	    (height > 64 - y)) /* check width, height */
+	{
+		handle->debug_print(
+			"ssd1306: width or height is invalid.\n"); /* width or height is invalid */
+
+		return 5; /* return error */
+	}
+	if ((format != SSD1306_BITMAP_FORMAT_ROW_MAJOR) &&
+	    (format != SSD1306_BITMAP_FORMAT_PAGE_MAJOR)) /* check format */
+	{
+		handle->debug_print(
+			"ssd1306: format is invalid.\n"); /* format is invalid */
+
+		return 6; /* return error */
+	}
+
+	bottom = (uint8_t)(y + height - 1); /* get the bottom */
+	shift = y % 8; /* get the page shift */
+	stride = (uint8_t)((width + 7) / 8); /* get the row bytes */
+	for (page = y / 8; page <= bottom / 8; page++) /* draw the pages */
+	{
+		mask = 0xFF; /* full page */
+		if (page == y / 8) /* if the first page */
+		{
+			mask &= (uint8_t)(0xFF << shift); /* cut the top */
+		}
+		if (page == bottom / 8) /* if the last page */
+		{
+			mask &= (uint8_t)(0xFF >> (7 - (bottom % 8))); /* cut the bottom */
+		}
+		if (format == SSD1306_BITMAP_FORMAT_PAGE_MAJOR) /* page-major */
+		{
+			k = (int16_t)(page - y / 8); /* the source page below */
+			if (shift == 0) /* if page aligned */
+			{
+				src = &bitmap[k * width]; /* use the source page */
+			} else {
+				for (i = 0; i < width; i++) /* shift the columns */
+				{
+					buf[i] = 0x00; /* init 0 */
+					if (k * 8 < height) /* check the lower page */
+					{
+						buf[i] |= (uint8_t)(bitmap[k * width + i]
+								    << shift); /* move down */
+					}
+					if (k > 0) /* check the upper page */
+					{
+						buf[i] |= (uint8_t)(bitmap[(k - 1) * width + i] >>
+								    (8 - shift)); /* move down */
+					}
+				}
+				src = (const uint8_t *)buf; /* use the buffer */
+			}
+		} else {
+			memset(buf, 0x00, width); /* clear the columns */
+			for (row = 0; row < 8; row++) /* build 8 rows */
+			{
+				if (((mask >> row) & 0x01) == 0) /* check the row */
+				{
+					continue; /* outside the bitmap */
+				}
+				sy = (uint8_t)(page * 8 + row - y); /* get the source row */
+				for (i = 0; i < width; i++) /* build the columns */
+				{
+					buf[i] |= (uint8_t)(((bitmap[sy * stride + i / 8] >>
+							     (7 - (i % 8))) &
+							    0x01)
+							   << row); /* move the bit */
+				}
+			}
+			src = (const uint8_t *)buf; /* use the buffer */
+		}
+		a_ssd1306_gram_copy_span(handle, page, x, width, src,
+					 mask); /* copy the span */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     draw a line in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x0 is the start coordinate x
+ * @param[in] y0 is the start coordinate y
+ * @param[in] x1 is the end coordinate x
+ * @param[in] y1 is the end coordinate y
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the line is clipped to the screen
+ */
+uint8_t ssd1306_gram_draw_line(ssd1306_handle_t *handle, int16_t x0,
+			       int16_t y0, int16_t x1, int16_t y1,
+			       uint8_t color)
+{
+	int64_t num;
+	int32_t major;
+	int32_t minor;
+	int32_t step;
+	int32_t end;
+	int32_t offset;
+	int32_t err;
+	int32_t a;
+	int32_t b;
+	int32_t b0;
+	int8_t sa;
+	int8_t sb;
+	int16_t limit_a;
+	int16_t limit_b;
+	uint8_t x_major;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	if (y0 == y1) /* if horizontal */
+	{
+		a_ssd1306_gram_hline(handle, (x0 < x1) ? x0 : x1,
+				     (x0 < x1) ? x1 : x0, y0,
+				     color); /* draw the span */
+
+		return 0; /* success return 0 */
+	}
+	if (x0 == x1) /* if vertical */
+	{
+		a_ssd1306_gram_vline(handle, x0, (y0 < y1) ? y0 : y1,
+				     (y0 < y1) ? y1 : y0,
+				     color); /* draw the column */
+
+		return 0; /* success return 0 */
+	}
+
+	x_major = (uint8_t)(((x1 > x0) ? (x1 - x0) : (x0 - x1)) >=
+			    ((y1 > y0) ? (y1 - y0) : (y0 - y1))); /* get the axis */
+	if (x_major != 0) /* step along x */
+	{
+		a = x0; /* major start */
+		b0 = y0; /* minor start */
+		major = (int32_t)x1 - x0; /* major delta */
+		minor = (int32_t)y1 - y0; /* minor delta */
+		limit_a = 127; /* major limit */
+		limit_b = 63; /* minor limit */
+	} else {
+		a = y0; /* major start */
+		b0 = x0; /* minor start */
+		major = (int32_t)y1 - y0; /* major delta */
+		minor = (int32_t)x1 - x0; /* minor delta */
+		limit_a = 63; /* major limit */
+		limit_b = 127; /* minor limit */
+	}
+	sa = (major > 0) ? 1 : -1; /* major direction */
+	sb = (minor > 0) ? 1 : -1; /* minor direction */
+	major = (major > 0) ? major : -major; /* major length */
+	minor = (minor > 0) ? minor : -minor; /* minor length */
+
+	if (sa > 0) /* clip the major axis once */
+	{
+		step = (a < 0) ? -a : 0; /* first visible step */
+		end = (a + major > limit_a) ? (limit_a - a) : major; /* last step */
+	} else {
+		step = (a > limit_a) ? (a - limit_a) : 0; /* first visible step */
+		end = (a - major < 0) ? a : major; /* last step */
+	}
+	if (step > end) /* check the range */
+	{
+		return 0; /* outside the screen */
+	}
+	num = 2 * (int64_t)step * minor + major; /* jump to the first step */
+	offset = (int32_t)(num / (2 * major)); /* minor offset */
+	err = (int32_t)(num % (2 * major)); /* error term */
+	for (; step <= end; step++) /* draw the steps */
+	{
+		b = b0 + sb * offset; /* get the minor */
+		if ((b >= 0) && (b <= limit_b)) /* check the minor axis */
+		{
+			if (x_major != 0) /* if x major */
+			{
+				a_ssd1306_gram_plot(handle, (int16_t)(x0 + sa * step),
+						    (int16_t)b, color); /* plot */
+			} else {
+				a_ssd1306_gram_plot(handle, (int16_t)b,
+						    (int16_t)(y0 + sa * step),
+						    color); /* plot */
+			}
+		} else if (((sb > 0) && (b > limit_b)) ||
+			   ((sb < 0) && (b < 0))) /* check leaving */
+		{
+			break; /* the rest is outside */
+		}
+		err += 2 * minor; /* next error */
+		if (err >= 2 * major) /* check the carry */
+		{
+			err -= 2 * major; /* carry */
+			offset++; /* next minor */
+		}
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     draw a circle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the center coordinate x
+ * @param[in] y is the center coordinate y
+ * @param[in] r is the radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the circle is clipped to the screen
+ */
+uint8_t ssd1306_gram_draw_circle(ssd1306_handle_t *handle, int16_t x,
+				 int16_t y, uint8_t r, uint8_t color)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	a_ssd1306_gram_circle(handle, x, y, r, 0, 0, 0,
+			      color); /* draw the circle */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     fill a circle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the center coordinate x
+ * @param[in] y is the center coordinate y
+ * @param[in] r is the radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the circle is clipped to the screen
+ */
+uint8_t ssd1306_gram_fill_circle(ssd1306_handle_t *handle, int16_t x,
+				 int16_t y, uint8_t r, uint8_t color)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+
+	a_ssd1306_gram_circle(handle, x, y, r, 0, 0, 1,
+			      color); /* fill the circle */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     draw an arc in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the center coordinate x
+ * @param[in] y is the center coordinate y
+ * @param[in] r is the radius
+ * @param[in] start is the start angle in degree
+ * @param[in] end is the end angle in degree
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 start or end is invalid
+ * @note      0 degree points to the right and the angle grows clockwise on the screen,
+ *            the arc runs clockwise from start to end and start == end draws the whole circle
+ */
+uint8_t ssd1306_gram_draw_arc(ssd1306_handle_t *handle, int16_t x, int16_t y,
+			      uint8_t r, uint16_t start, uint16_t end,
+			      uint8_t color)
+{
+	int32_t sx, sy;
+	int32_t ex, ey;
+	int32_t px, py;
+	int32_t dx, dy;
+	int32_t f;
+	uint8_t major;
+	uint8_t i;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((start > 359) || (end > 359)) /* check the angles */
+	{
+		handle->debug_print(
+			"ssd1306: start or end is invalid.\n"); /* start or end is invalid */
+
+		return 4; /* return error */
+	}
+	if (start == end) /* if the whole circle */
+	{
+		a_ssd1306_gram_circle(handle, x, y, r, 0, 0, 0,
+				      color); /* draw the circle */
+
+		return 0; /* success return 0 */
+	}
+
+	a_ssd1306_angle_vector(start, &sx, &sy); /* get the start vector */
+	a_ssd1306_angle_vector(end, &ex, &ey); /* get the end vector */
+	major = (uint8_t)(((end + 360 - start) % 360) > 180); /* get the sweep */
+	px = 0; /* init x */
+	py = r; /* init y */
+	f = 1 - (int32_t)r; /* init decision */
+	while (px <= py) /* walk one octant */
+	{
+		for (i = 0; i < 8; i++) /* mirror 8 octants */
+		{
+			dx = (i & 0x04) ? py : px; /* swap */
+			dy = (i & 0x04) ? px : py; /* swap */
+			dx = (i & 0x01) ? -dx : dx; /* mirror x */
+			dy = (i & 0x02) ? -dy : dy; /* mirror y */
+			if (a_ssd1306_angle_inside(dx, dy, sx, sy, ex, ey,
+						   major) != 0) /* check the angle */
+			{
+				a_ssd1306_gram_plot(handle, (int16_t)(x + dx),
+						    (int16_t)(y + dy),
+						    color); /* plot */
+			}
+		}
+		if (f >= 0) /* check the decision */
+		{
+			py--; /* step y */
+			f -= 2 * py; /* update */
+		}
+		px++; /* step x */
+		f += 2 * px + 1; /* update */
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     draw a rounded rectangle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] r is the corner radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 left > right or top > bottom
+ *            - 5 r is invalid
+ * @note      the rectangle is clipped to the screen
+ */
+uint8_t ssd1306_gram_draw_round_rect(ssd1306_handle_t *handle, int16_t left,
+				     int16_t top, int16_t right,
+				     int16_t bottom, uint8_t r, uint8_t color)
+{
+	return a_ssd1306_gram_round_rect(handle, left, top, right, bottom, r,
+					 0, color); /* draw the rect */
+}
+
+/**
+ * @brief     fill a rounded rectangle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] r is the corner radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 left > right or top > bottom
+ *            - 5 r is invalid
+ * @note      the rectangle is clipped to the screen
+ */
+uint8_t ssd1306_gram_fill_round_rect(ssd1306_handle_t *handle, int16_t left,
+				     int16_t top, int16_t right,
+				     int16_t bottom, uint8_t r, uint8_t color)
+{
+	return a_ssd1306_gram_round_rect(handle, left, top, right, bottom, r,
+					 1, color); /* fill the rect */
+}
+
+/**
+ * @brief     fill a polygon in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *point points to a vertex buffer
+ * @param[in] num is the vertex number
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 point or num is invalid
+ * @note      rows are filled by the even-odd rule at the row of each pixel,
+ *            num must be in range of 3 to SSD1306_POLYGON_MAX_POINT
+ */
+uint8_t ssd1306_gram_fill_polygon(ssd1306_handle_t *handle,
+				  const ssd1306_point_t *point, uint8_t num,
+				  uint8_t color)
+{
+	int16_t node[SSD1306_POLYGON_MAX_POINT];
+	int16_t top;
+	int16_t bottom;
+	int16_t y;
+	int16_t t;
+	uint8_t count;
+	uint8_t i;
+	uint8_t j;
+
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if ((point == NULL) || (num < 3) ||
+	    (num > SSD1306_POLYGON_MAX_POINT)) /* check point and num */
+	{
+		handle->debug_print(
+			"ssd1306: point or num is invalid.\n"); /* point or num is invalid */
+
+		return 4; /* return error */
+	}
+
+	top = point[0].y; /* init top */
+	bottom = point[0].y; /* init bottom */
+	for (i = 1; i < num; i++) /* find the rows */
+	{
+		top = (point[i].y < top) ? point[i].y : top; /* get top */
+		bottom = (point[i].y > bottom) ? point[i].y : bottom; /* get bottom */
+	}
+	top = (top < 0) ? 0 : top; /* clip the top once */
+	bottom = (bottom > 63) ? 63 : bottom; /* clip the bottom once */
+	for (y = top; y <= bottom; y++) /* scan the rows */
+	{
+		count = 0; /* no node */
+		for (i = 0, j = num - 1; i < num; j = i, i++) /* walk the edges */
+		{
+			if (((point[i].y <= y) && (point[j].y > y)) ||
+			    ((point[j].y <= y) && (point[i].y > y))) /* check crossing */
+			{
+				node[count++] = (int16_t)(
+					point[i].x +
+					((int32_t)(y - point[i].y) *
+					 (point[j].x - point[i].x)) /
+						(point[j].y - point[i].y)); /* crossing x */
+			}
+		}
+		for (i = 1; i < count; i++) /* sort the nodes */
+		{
+			t = node[i]; /* save the node */
+			for (j = i; (j > 0) && (node[j - 1] > t); j--) /* find the place */
+			{
+				node[j] = node[j - 1]; /* move the node */
+			}
+			node[j] = t; /* insert the node */
+		}
+		for (i = 0; i + 1 < count; i += 2) /* fill the pairs */
+		{
+			a_ssd1306_gram_hline(handle, node[i], node[i + 1], y,
+					     color); /* fill the span */
+		}
+	}
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 reset failed
+ *            - 5 command && data init failed
+ *            - 6 interface param is invalid
+ * @note      none
+ */
+uint8_t ssd1306_init(ssd1306_handle_t *handle)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->debug_print == NULL) /* check debug_print */
+	{
+		return 3; /* return error */
+	}
+	if (handle->iic_init == NULL) /* check iic_init */
+	{
+		handle->debug_print(
+			"ssd1306: iic_init is null.\n"); /* iic_init is null */
+
+		return 3; /* return error */
+	}
+	if (handle->iic_deinit == NULL) /* check iic_deinit */
+	{
+		handle->debug_print(
+			"ssd1306: iic_deinit is null.\n"); /* iic_deinit is null */
+
+		return 3; /* return error */
+	}
+	if (handle->iic_write == NULL) /* check iic_write */
+	{
+		handle->debug_print(
+			"ssd1306: iic_write is null.\n"); /* iic_write is null */
+
+		return 3; /* return error */
+	}
+	if (handle->spi_init == NULL) /* check spi_init */
+	{
+		handle->debug_print(
+			"ssd1306: spi_init is null.\n"); /* spi_init is null */
+
+		return 3; /* return error */
+	}
+	if (handle->spi_deinit == NULL) /* check spi_deinit */
+	{
+		handle->debug_print(
+			"ssd1306: spi_deinit is null.\n"); /* spi_deinit is null */
+
+		return 3; /* return error */
+	}
+	if (handle->spi_write_cmd == NULL) /* check spi_write_cmd */
+	{
+		handle->debug_print(
+			"ssd1306: spi_write_cmd is null.\n"); /* spi_write_cmd is null */
+
+		return 3; /* return error */
+	}
+	if (handle->delay_ms == NULL) /* check delay_ms */
+	{
+		handle->debug_print(
+			"ssd1306: delay_ms is null.\n"); /* delay_ms is null */
+
+		return 3; /* return error */
+	}
+	if (handle->spi_cmd_data_gpio_init ==
+	    NULL) /* check spi_cmd_data_gpio_init */
+	{
+		handle->debug_print(
+			"ssd1306: spi_cmd_data_gpio_init is null.\n"); /* spi_cmd_data_gpio_init is null */
+
+		return 3; /* return error */
+	}
+	if (handle->spi_cmd_data_gpio_deinit ==
+	    NULL) /* check spi_cmd_data_gpio_deinit */
+	{
+		handle->debug_print(
+			"ssd1306: spi_cmd_data_gpio_deinit is null.\n"); /* spi_cmd_data_gpio_deinit is null */
+
+		return 3; /* return error */
+	}
+	if (handle->spi_cmd_data_gpio_write ==
+	    NULL) /* check spi_cmd_data_gpio_write */
+	{
+		handle->debug_print(
+			"ssd1306: spi_cmd_data_gpio_write is null.\n"); /* spi_cmd_data_gpio_write is null */
+
+		return 3; /* return error */
+	}
+	if (handle->reset_gpio_init == NULL) /* check reset_gpio_init */
+	{
+		handle->debug_print(
+			"ssd1306: reset_gpio_init is null.\n"); /* reset_gpio_init is null */
+
+		return 3; /* return error */
+	}
+	if (handle->reset_gpio_deinit == NULL) /* check reset_gpio_deinit */
+	{
+		handle->debug_print(
+			"ssd1306: reset_gpio_deinit is null.\n"); /* reset_gpio_deinit is null */
+
+		return 3; /* return error */
+	}
+	if (handle->reset_gpio_write == NULL) /* check reset_gpio_write */
+	{
+		handle->debug_print(
+			"ssd1306: reset_gpio_write is null.\n"); /* reset_gpio_write is null */
+
+		return 3; /* return error */
+	}
+
+	if (handle->spi_cmd_data_gpio_init() !=
+	    0) /* check spi_cmd_data_gpio_init */
+	{
+		handle->debug_print(
+			"ssd1306: spi cmd data gpio init failed.\n"); /* spi cmd data gpio init failed */
+
+		return 5; /* return error */
+	}
+	if (handle->reset_gpio_init() != 0) /* reset gpio init */
+	{
+		handle->debug_print(
+			"ssd1306: reset gpio init failed.\n"); /* reset gpio init failed */
+		(void)handle
+			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
+
+		return 4; /* return error */
+	}
+	if (handle->reset_gpio_write(0) != 0) /* write 0 */
+	{
+		handle->debug_print(
+			"ssd1306: reset gpio write failed.\n"); /* reset gpio write failed */
+		(void)handle
+			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
+		(void)handle->reset_gpio_deinit(); /* reset_gpio_deinit */
+
+		return 4; /* return error */
+	}
+	handle->delay_ms(100); /* delay 100 ms */
+	if (handle->reset_gpio_write(1) != 0) /* write 1 */
+	{
+		handle->debug_print(
+			"ssd1306: reset gpio write failed.\n"); /* reset gpio write failed */
+		(void)handle
+			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
+		(void)handle->reset_gpio_deinit(); /* reset_gpio_deinit */
+
+		return 4; /* return error */
+	}
+	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic interface */
+	{
+		if (handle->iic_init() != 0) /* iic init */
+		{
+			handle->debug_print(
+				"ssd1306: iic init failed.\n"); /* iic init failed */
+			(void)handle
+				->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
+			(void)handle
+				->reset_gpio_deinit(); /* reset_gpio_deinit */
+
+			return 1; /* return error */
+		}
+	} else if (handle->iic_spi ==
+		   SSD1306_INTERFACE_SPI) /* if spi interface */
+	{
+		if (handle->spi_init() != 0) /* spi init */
+		{
+			handle->debug_print(
+				"ssd1306: spi init failed.\n"); /* spi init failed */
+			(void)handle
+				->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
+			(void)handle
+				->reset_gpio_deinit(); /* reset_gpio_deinit */
+
+			return 1; /* return error */
+		}
+#if (SSD1306_SPI_3WIRE == 1)
+	} else if (handle->iic_spi ==
+		   SSD1306_INTERFACE_SPI_3WIRE) /* if 3-wire spi interface */
+	{
+		if (handle->spi_init() != 0) /* spi init */
+		{
+			handle->debug_print(
+				"ssd1306: spi init failed.\n"); /* spi init failed */
+			(void)handle
+				->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
+			(void)handle
+				->reset_gpio_deinit(); /* reset_gpio_deinit */
+
+			return 1; /* return error */
+		}
+#endif
+	} else {
+		handle->debug_print(
+			"ssd1306: interface is invalid.\n"); /* interface is invalid */
+		(void)handle
+			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
+		(void)handle->reset_gpio_deinit(); /* reset_gpio_deinit */
+
+		return 6; /* return error */
+	}
+	handle->addressing_mode = 0xFF; /* addressing mode is unknown */
+	handle->dc_level = 0xFF; /* command data level is unknown */
+	handle->batch_enable = 0; /* no batch */
+	handle->batch_len = 0; /* empty queue */
+#if (SSD1306_SPI_3WIRE == 1)
+	handle->spi_3wire_batch = 0; /* no spi batch */
+	handle->spi_3wire_seg_num = 0; /* no segment */
+#endif
+#if (SSD1306_DOUBLE_BUFFER == 1)
+	handle->front = 1; /* flush the second buffer, draw into the first */
+#endif
+#if (SSD1306_ASYNC_FLUSH == 1)
+	handle->async_busy = 0; /* no asynchronous flush */
+	handle->async_done = 0; /* no result */
+#endif
+#if (SSD1306_TRACE_SIZE > 0)
+	handle->trace_count = 0; /* clear the trace */
+#endif
+#if (SSD1306_STATS == 1)
+	memset(&handle->stats, 0, sizeof(ssd1306_stats_t)); /* clear the stats */
+#if (SSD1306_SPI_3WIRE == 1)
+	handle->spi_3wire_seg_data = 0; /* no data segment */
+#endif
+#endif
+	a_ssd1306_set_dirty_all(handle, 1); /* the chip ram is unknown */
+	a_ssd1306_shadow_invalidate(handle); /* the shadow is unknown */
+	handle->inited = 1; /* flag inited */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 power down failed
+ *            - 5 reset gpio deinit failed
+ *            - 6 command && data deinit failed
+ *            - 7 interface param is invalid
+ * @note      none
+ */
+uint8_t ssd1306_deinit(ssd1306_handle_t *handle)
+{
+	uint8_t buf[2];
+
+	if (handle == NULL) /* check handle */
 	{
 		return 2; /* return error */
 	}
-	if (handle->debug_print == NULL) /* check debug_print */
+	if (handle->inited != 1) /* check handle initialization */
 	{
 		return 3; /* return error */
 	}
-	if (handle->iic_init == NULL) /* check iic_init */
-	{
-		handle->debug_print(
-			"ssd1306: iic_init is null.\n"); /* iic_init is null */
 
-		return 3; /* return error */
-	}
-	if (handle->iic_deinit == NULL) /* check iic_deinit */
+	handle->batch_enable = 0; /* stop the batch */
+	if (a_ssd1306_batch_flush(handle) != 0) /* send the queued commands */
 	{
 		handle->debug_print(
-			"ssd1306: iic_deinit is null.\n"); /* iic_deinit is null */
+			"ssd1306: write command failed.\n"); /* write command failed */
 
-		return 3; /* return error */
+		return 4; /* return error */
 	}
-	if (handle->iic_write == NULL) /* check iic_write */
+	buf[0] = SSD1306_CMD_CHARGE_PUMP_SETTING; /* charge pump off */
+	buf[1] = 0x10 | (0 << 2); /* set charge pump */
+	if (a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, 2,
+					  SSD1306_CMD) != 0) /* write command */
 	{
 		handle->debug_print(
-			"ssd1306: iic_write is null.\n"); /* iic_write is null */
+			"ssd1306: write command failed.\n"); /* write command failed */
 
-		return 3; /* return error */
+		return 4; /* return error */
 	}
-	if (handle->spi_init == NULL) /* check spi_init */
+	if (a_ssd1306_write_byte(handle, SSD1306_CMD_DISPLAY_OFF,
+				 SSD1306_CMD) != 0) /* write display off */
 	{
 		handle->debug_print(
-			"ssd1306: spi_init is null.\n"); /* spi_init is null */
+			"ssd1306: write command failed.\n"); /* write command failed */
 
-		return 3; /* return error */
+		return 4; /* return error */
 	}
-	if (handle->spi_deinit == NULL) /* check spi_deinit */
+	if (handle->reset_gpio_deinit() != 0) /* reset gpio deinit */
 	{
 		handle->debug_print(
-			"ssd1306: spi_deinit is null.\n"); /* spi_deinit is null */
+			"ssd1306: reset gpio deinit failed.\n"); /* reset gpio deinit failed */
 
-		return 3; /* return error */
+		return 5; /* return error */
 	}
-	if (handle->spi_write_cmd == NULL) /* check spi_write_cmd */
+	if (handle->spi_cmd_data_gpio_deinit() !=
+	    0) /* spi cmd data gpio deinit */
 	{
 		handle->debug_print(
-			"ssd1306: spi_write_cmd is null.\n"); /* spi_write_cmd is null */
+			"ssd1306: spi cmd data gpio deinit failed.\n"); /* spi cmd data gpio deinit failed */
 
-		return 3; /* return error */
+		return 6; /* return error */
 	}
-	if (handle->delay_ms == NULL) /* check delay_ms */
+	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic interface */
 	{
-		handle->debug_print(
-			"ssd1306: delay_ms is null.\n"); /* delay_ms is null */
+		if (handle->iic_deinit() != 0) /* iic deinit */
+		{
+			handle->debug_print(
+				"ssd1306: iic deinit failed.\n"); /* iic deinit failed */
 
-		return 3; /* return error */
-	}
-	if (handle->spi_cmd_data_gpio_init ==
-	    NULL) /* check spi_cmd_data_gpio_init */
+			return 1; /* return error */
+		}
+	} else if ((handle->iic_spi == SSD1306_INTERFACE_SPI) ||
+		   (handle->iic_spi ==
+		    SSD1306_INTERFACE_SPI_3WIRE)) /* if spi interface */
 	{
-		handle->debug_print(
-			"ssd1306: spi_cmd_data_gpio_init is null.\n"); /* spi_cmd_data_gpio_init is null */
+		if (handle->spi_deinit() != 0) /* spi deinit */
+		{
+			handle->debug_print(
+				"ssd1306: spi deinit failed.\n"); /* spi deinit failed */
 
-		return 3; /* return error */
-	}
-	if (handle->spi_cmd_data_gpio_deinit ==
-	    NULL) /* check spi_cmd_data_gpio_deinit */
-	{
+			return 1; /* return error */
+		}
+	} else {
 		handle->debug_print(
-			"ssd1306: spi_cmd_data_gpio_deinit is null.\n"); /* spi_cmd_data_gpio_deinit is null */
+			"ssd1306: interface is invalid.\n"); /* interface is invalid */
 
-		return 3; /* return error */
+		return 7; /* return error */
 	}
-	if (handle->spi_cmd_data_gpio_write ==
-	    NULL) /* check spi_cmd_data_gpio_write */
-	{
-		handle->debug_print(
-			"ssd1306: spi_cmd_data_gpio_write is null.\n"); /* spi_cmd_data_gpio_write is null */
+	handle->inited = 0; /* flag close */
 
-		return 3; /* return error */
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     set the chip interface
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] interface is the chip interface
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t ssd1306_set_interface(ssd1306_handle_t *handle,
+			      ssd1306_interface_t interface)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
 	}
-	if (handle->reset_gpio_init == NULL) /* check reset_gpio_init */
+
+	handle->iic_spi = (uint8_t)interface; /* set interface */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      get the chip interface
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *interface points to a chip interface buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1306_get_interface(ssd1306_handle_t *handle,
+			      ssd1306_interface_t *interface)
+{
+	if (handle == NULL) /* check handle */
 	{
-		handle->debug_print(
-			"ssd1306: reset_gpio_init is null.\n"); /* reset_gpio_init is null */
+		return 2; /* return error */
+	}
 
-		return 3; /* return error */
+	*interface = (ssd1306_interface_t)(handle->iic_spi); /* get interface */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     set the chip iic address
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] addr_pin is the iic address
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t ssd1306_set_addr_pin(ssd1306_handle_t *handle,
+			     ssd1306_address_t addr_pin)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
 	}
-	if (handle->reset_gpio_deinit == NULL) /* check reset_gpio_deinit */
+
+	handle->iic_addr = (uint8_t)addr_pin; /* set addr pin */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      get the chip iic address
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *addr_pin points to an iic address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1306_get_addr_pin(ssd1306_handle_t *handle,
+			     ssd1306_address_t *addr_pin)
+{
+	if (handle == NULL) /* check handle */
 	{
-		handle->debug_print(
-			"ssd1306: reset_gpio_deinit is null.\n"); /* reset_gpio_deinit is null */
+		return 2; /* return error */
+	}
 
-		return 3; /* return error */
+	*addr_pin = (ssd1306_address_t)(handle->iic_addr); /* set address */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     set the gram flush mode
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] mode is the flush mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t ssd1306_set_flush_mode(ssd1306_handle_t *handle,
+			       ssd1306_flush_mode_t mode)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
 	}
-	if (handle->reset_gpio_write == NULL) /* check reset_gpio_write */
+
+	handle->flush_mode = (uint8_t)mode; /* set flush mode */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      get the gram flush mode
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *mode points to a flush mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1306_get_flush_mode(ssd1306_handle_t *handle,
+			       ssd1306_flush_mode_t *mode)
+{
+	if (handle == NULL) /* check handle */
 	{
-		handle->debug_print(
-			"ssd1306: reset_gpio_write is null.\n"); /* reset_gpio_write is null */
+		return 2; /* return error */
+	}
 
-		return 3; /* return error */
+	*mode = (ssd1306_flush_mode_t)(handle->flush_mode); /* get flush mode */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     set the iic transport
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] transport is the iic transport
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the continuation transport sends each page write as one iic
+ *            message
+ */
+uint8_t ssd1306_set_iic_transport(ssd1306_handle_t *handle,
+				  ssd1306_iic_transport_t transport)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
 	}
 
-	if (handle->spi_cmd_data_gpio_init() !=
-	    0) /* check spi_cmd_data_gpio_init */
+	handle->iic_transport = (uint8_t)transport; /* set iic transport */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief      get the iic transport
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *transport points to an iic transport buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1306_get_iic_transport(ssd1306_handle_t *handle,
+				  ssd1306_iic_transport_t *transport)
+{
+	if (handle == NULL) /* check handle */
 	{
-		handle->debug_print(
-			"ssd1306: spi cmd data gpio init failed.\n"); /* spi cmd data gpio init failed */
+		return 2; /* return error */
+	}
 
-		return 5; /* return error */
+	*transport = (ssd1306_iic_transport_t)(
+		handle->iic_transport); /* get iic transport */
+
+	return 0; /* success return 0 */
+}
+
+/**
+ * @brief     set the bus clock
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] hz is the bus clock in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set bus speed failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 bus speed is not supported
+ * @note      none
+ */
+uint8_t ssd1306_set_bus_speed(ssd1306_handle_t *handle, uint32_t hz)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
 	}
-	if (handle->reset_gpio_init() != 0) /* reset gpio init */
+	if (handle->inited != 1) /* check handle initialization */
 	{
-		handle->debug_print(
-			"ssd1306: reset gpio init failed.\n"); /* reset gpio init failed */
-		(void)handle
-			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
-
-		return 4; /* return error */
+		return 3; /* return error */
 	}
-	if (handle->reset_gpio_write(0) != 0) /* write 0 */
+	if (handle->bus_set_speed == NULL) /* check the hook */
 	{
 		handle->debug_print(
-			"ssd1306: reset gpio write failed.\n"); /* reset gpio write failed */
-		(void)handle
-			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
-		(void)handle->reset_gpio_deinit(); /* reset_gpio_deinit */
+			"ssd1306: bus speed is not supported.\n"); /* bus speed is not supported */
 
 		return 4; /* return error */
 	}
-	handle->delay_ms(100); /* delay 100 ms */
-	if (handle->reset_gpio_write(1) != 0) /* write 1 */
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* the clock must not change during a transfer */
+#endif
+	if (handle->bus_set_speed(handle->iic_spi, hz) != 0) /* set the clock */
 	{
 		handle->debug_print(
-			"ssd1306: reset gpio write failed.\n"); /* reset gpio write failed */
-		(void)handle
-			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
-		(void)handle->reset_gpio_deinit(); /* reset_gpio_deinit */
+			"ssd1306: set bus speed failed.\n"); /* set bus speed failed */
 
-		return 4; /* return error */
+		return 1; /* return error */
 	}
-	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic interface */
-	{
-		if (handle->iic_init() != 0) /* iic init */
-		{
-			handle->debug_print(
-				"ssd1306: iic init failed.\n"); /* iic init failed */
-			(void)handle
-				->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
-			(void)handle
-				->reset_gpio_deinit(); /* reset_gpio_deinit */
-
-			return 1; /* return error */
-		}
-	} else if (handle->iic_spi ==
-		   SSD1306_INTERFACE_SPI) /* if spi interface */
-	{
-		if (handle->spi_init() != 0) /* spi init */
-		{
-			handle->debug_print(
-				"ssd1306: spi init failed.\n"); /* spi init failed */
-			(void)handle
-				->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
-			(void)handle
-				->reset_gpio_deinit(); /* reset_gpio_deinit */
+	handle->bus_speed = hz; /* save the clock */
 
-			return 1; /* return error */
-		}
-	} else {
-		handle->debug_print(
-			"ssd1306: interface is invalid.\n"); /* interface is invalid */
-		(void)handle
-			->spi_cmd_data_gpio_deinit(); /* spi_cmd_data_gpio_deinit */
-		(void)handle->reset_gpio_deinit(); /* reset_gpio_deinit */
+	return 0; /* success return 0 */
+}
 
-		return 6; /* return error */
+/**
+ * @brief      get the bus clock
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *hz points to a bus clock buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       0 means the interface default clock
+ */
+uint8_t ssd1306_get_bus_speed(ssd1306_handle_t *handle, uint32_t *hz)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
 	}
-	handle->inited = 1; /* flag inited */
+
+	*hz = handle->bus_speed; /* get the clock */
 
 	return 0; /* success return 0 */
 }
 
 /**
- * @brief     close the chip
- * @param[in] *handle points to an ssd1306 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 iic or spi deinit failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 power down failed
- *            - 5 reset gpio deinit failed
- *            - 6 command && data deinit failed
- *            - 7 interface param is invalid
- * @note      none
+ * @brief      probe the fastest stable bus clock
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[in]  *rate points to a rising bus clock list in hz
+ * @param[in]  num is the list length
+ * @param[out] *hz points to a bus clock buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no clock is stable
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 bus speed is not supported
+ *             - 5 rate list is invalid
+ *             - 6 the current bus speed is unknown
+ * @note       a test pattern frame is written at each clock until a write
+ *             fails or the bus_read_back echo differs, the fastest stable
+ *             clock stays set and the gram is written again, the clock set by
+ *             ssd1306_set_bus_speed is the fallback and it is restored if no
+ *             clock is stable
  */
-uint8_t ssd1306_deinit(ssd1306_handle_t *handle)
+uint8_t ssd1306_probe_bus_speed(ssd1306_handle_t *handle,
+				const uint32_t *rate, uint8_t num, uint32_t *hz)
 {
-	uint8_t buf[2];
+	uint8_t pattern[128];
+	uint8_t echo[128];
+	uint8_t cmd[8];
+	uint8_t len;
+	uint8_t stable;
+	uint8_t i;
+	uint8_t j;
+	uint8_t k;
+	uint32_t best;
 
 	if (handle == NULL) /* check handle */
 	{
@@ -1123,154 +4674,200 @@ uint8_t ssd1306_deinit(ssd1306_handle_t *handle)
 	{
 		return 3; /* return error */
 	}
-
-	buf[0] = SSD1306_CMD_CHARGE_PUMP_SETTING; /* charge pump off */
-	buf[1] = 0x10 | (0 << 2); /* set charge pump */
-	if (a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, 2,
-					  SSD1306_CMD) != 0) /* write command */
+	if (handle->bus_set_speed == NULL) /* check the hook */
 	{
 		handle->debug_print(
-			"ssd1306: write command failed.\n"); /* write command failed */
+			"ssd1306: bus speed is not supported.\n"); /* bus speed is not supported */
 
 		return 4; /* return error */
 	}
-	if (a_ssd1306_write_byte(handle, SSD1306_CMD_DISPLAY_OFF,
-				 SSD1306_CMD) != 0) /* write display off */
+	if ((rate == NULL) || (num == 0)) /* check the list */
 	{
 		handle->debug_print(
-			"ssd1306: write command failed.\n"); /* write command failed */
+			"ssd1306: rate list is invalid.\n"); /* rate list is invalid */
 
-		return 4; /* return error */
+		return 5; /* return error */
 	}
-	if (handle->reset_gpio_deinit() != 0) /* reset gpio deinit */
+	for (i = 1; i < num; i++) /* check the order */
 	{
-		handle->debug_print(
-			"ssd1306: reset gpio deinit failed.\n"); /* reset gpio deinit failed */
+		if (rate[i] <= rate[i - 1]) /* check rising */
+		{
+			handle->debug_print(
+				"ssd1306: rate list is invalid.\n"); /* rate list is invalid */
 
-		return 5; /* return error */
+			return 5; /* return error */
+		}
 	}
-	if (handle->spi_cmd_data_gpio_deinit() !=
-	    0) /* spi cmd data gpio deinit */
+	if (handle->bus_speed == 0) /* check the fallback */
 	{
 		handle->debug_print(
-			"ssd1306: spi cmd data gpio deinit failed.\n"); /* spi cmd data gpio deinit failed */
+			"ssd1306: the current bus speed is unknown.\n"); /* the current bus speed is unknown */
 
 		return 6; /* return error */
 	}
-	if (handle->iic_spi == SSD1306_INTERFACE_IIC) /* if iic interface */
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+	a_ssd1306_async_wait(
+		handle); /* the clock must not change during a transfer */
+#endif
+	best = 0; /* no stable clock */
+	for (i = 0; i < num; i++) /* try the clocks */
 	{
-		if (handle->iic_deinit() != 0) /* iic deinit */
+		if (handle->bus_set_speed(handle->iic_spi, rate[i]) !=
+		    0) /* set the clock */
+		{
+			if (i == 0) /* if no clock can be set */
+			{
+				handle->debug_print(
+					"ssd1306: bus speed is not supported.\n"); /* bus speed is not supported */
+
+				return 4; /* return error */
+			}
+
+			break; /* the clock is not supported */
+		}
+		len = a_ssd1306_frame_command(handle, (uint8_t *)cmd); /* build */
+		if (a_ssd1306_multiple_write_byte(handle, (uint8_t *)cmd, len,
+						  SSD1306_CMD) != 0) /* set frame */
+		{
+			break; /* the clock is not stable */
+		}
+		handle->addressing_mode =
+			SSD1306_FRAME_ADDRESSING_MODE; /* save addressing mode */
+		stable = 1; /* init 1 */
+		for (j = 0; j < 8; j++) /* write 8 page */
+		{
+			for (k = 0; k < 128; k++) /* build the pattern */
+			{
+				pattern[k] = (uint8_t)(((k + j + i) & 0x01) ? 0xAA :
+									     0x55); /* checker */
+			}
+			if (a_ssd1306_multiple_write_byte(handle,
+							  (uint8_t *)pattern,
+							  128, SSD1306_DATA) !=
+			    0) /* write the pattern */
+			{
+				stable = 0; /* write failed */
+
+				break; /* break */
+			}
+			if (handle->bus_read_back != NULL) /* if loopback */
+			{
+				if ((handle->bus_read_back((uint8_t *)echo, 128) !=
+				     0) ||
+				    (memcmp(echo, pattern, 128) !=
+				     0)) /* check the echo */
+				{
+					stable = 0; /* echo differs */
+
+					break; /* break */
+				}
+			}
+		}
+		if (stable == 0) /* check stable */
+		{
+			break; /* the clock is not stable */
+		}
+		best = rate[i]; /* save the clock */
+	}
+	handle->addressing_mode = 0xFF; /* the mode is unknown */
+	a_ssd1306_shadow_invalidate(handle); /* the pattern is in the chip */
+	a_ssd1306_set_dirty_all(handle, 1); /* the pattern is in the chip */
+	if (best == 0) /* check the result */
+	{
+		if (handle->bus_set_speed(handle->iic_spi, handle->bus_speed) !=
+		    0) /* restore the clock */
 		{
 			handle->debug_print(
-				"ssd1306: iic deinit failed.\n"); /* iic deinit failed */
+				"ssd1306: set bus speed failed.\n"); /* set bus speed failed */
 
 			return 1; /* return error */
 		}
-	} else if (handle->iic_spi ==
-		   SSD1306_INTERFACE_SPI) /* if spi interface */
+		handle->debug_print(
+			"ssd1306: no bus speed is stable.\n"); /* no bus speed is stable */
+
+		return 1; /* return error */
+	}
+	if (best != rate[num - 1]) /* if a faster clock was tried */
 	{
-		if (handle->spi_deinit() != 0) /* spi deinit */
+		if (handle->bus_set_speed(handle->iic_spi, best) !=
+		    0) /* set the best clock */
 		{
 			handle->debug_print(
-				"ssd1306: spi deinit failed.\n"); /* spi deinit failed */
+				"ssd1306: set bus speed failed.\n"); /* set bus speed failed */
 
 			return 1; /* return error */
 		}
-	} else {
+	}
+	handle->bus_speed = best; /* save the clock */
+	*hz = best; /* set the clock */
+	if (a_ssd1306_write_gram(handle) != 0) /* restore the screen */
+	{
 		handle->debug_print(
-			"ssd1306: interface is invalid.\n"); /* interface is invalid */
+			"ssd1306: write byte failed.\n"); /* write byte failed */
 
-		return 7; /* return error */
+		return 1; /* return error */
 	}
-	handle->inited = 0; /* flag close */
+	a_ssd1306_set_dirty_all(handle, 0); /* clear dirty */
 
 	return 0; /* success return 0 */
 }
 
 /**
- * @brief     set the chip interface
+ * @brief     begin a command batch
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] interface is the chip interface
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
- * @note      none
+ *            - 3 handle is not initialized
+ * @note      the commands of the following calls are queued in the handle
+ *            until ssd1306_command_batch_commit or the next data write
  */
-uint8_t ssd1306_set_interface(ssd1306_handle_t *handle,
-			      ssd1306_interface_t interface)
+uint8_t ssd1306_command_batch_begin(ssd1306_handle_t *handle)
 {
 	if (handle == NULL) /* check handle */
 	{
 		return 2; /* return error */
 	}
-
-	handle->iic_spi = (uint8_t)interface; /* set interface */
-
-	return 0; /* success return 0 */
-}
-
-/**
- * @brief      get the chip interface
- * @param[in]  *handle points to an ssd1306 handle structure
- * @param[out] *interface points to a chip interface buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- * @note       none
- */
-uint8_t ssd1306_get_interface(ssd1306_handle_t *handle,
-			      ssd1306_interface_t *interface)
-{
-	if (handle == NULL) /* check handle */
+	if (handle->inited != 1) /* check handle initialization */
 	{
-		return 2; /* return error */
+		return 3; /* return error */
 	}
 
-	*interface = (ssd1306_interface_t)(handle->iic_spi); /* get interface */
+	handle->batch_enable = 1; /* start the batch */
 
 	return 0; /* success return 0 */
 }
 
 /**
- * @brief     set the chip iic address
+ * @brief     commit a command batch
  * @param[in] *handle points to an ssd1306 handle structure
- * @param[in] addr_pin is the iic address
  * @return    status code
  *            - 0 success
+ *            - 1 commit failed
  *            - 2 handle is NULL
- * @note      none
+ *            - 3 handle is not initialized
+ * @note      all queued commands are sent in one transaction
  */
-uint8_t ssd1306_set_addr_pin(ssd1306_handle_t *handle,
-			     ssd1306_address_t addr_pin)
+uint8_t ssd1306_command_batch_commit(ssd1306_handle_t *handle)
 {
 	if (handle == NULL) /* check handle */
 	{
 		return 2; /* return error */
 	}
-
-	handle->iic_addr = (uint8_t)addr_pin; /* set addr pin */
-
-	return 0; /* success return 0 */
-}
-
-/**
- * @brief      get the chip iic address
- * @param[in]  *handle points to an ssd1306 handle structure
- * @param[out] *addr_pin points to an iic address buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- * @note       none
- */
-uint8_t ssd1306_get_addr_pin(ssd1306_handle_t *handle,
-			     ssd1306_address_t *addr_pin)
-{
-	if (handle == NULL) /* check handle */
+	if (handle->inited != 1) /* check handle initialization */
 	{
-		return 2; /* return error */
+		return 3; /* return error */
 	}
 
-	*addr_pin = (ssd1306_address_t)(handle->iic_addr); /* set address */
+	handle->batch_enable = 0; /* stop the batch */
+	if (a_ssd1306_batch_flush(handle) != 0) /* send the queue */
+	{
+		handle->debug_print(
+			"ssd1306: write command failed.\n"); /* write command failed */
+
+		return 1; /* return error */
+	}
 
 	return 0; /* success return 0 */
 }
@@ -1375,9 +4972,14 @@ ssd1306_set_memory_addressing_mode(ssd1306_handle_t *handle,
 
 	buf[0] = SSD1306_CMD_MEMORY_ADDRESSING_MODE; /* set command mode */
 	buf[1] = mode; /* set mode */
+	if (a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, 2,
+					  SSD1306_CMD) != 0) /* write command */
+	{
+		return 1; /* return error */
+	}
+	handle->addressing_mode = (uint8_t)mode; /* save addressing mode */
 
-	return a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, 2,
-					     SSD1306_CMD); /* write command */
+	return 0; /* success return 0 */
 }
 
 /**
@@ -1785,6 +5387,9 @@ uint8_t ssd1306_deactivate_scroll(ssd1306_handle_t *handle)
 		return 3; /* return error */
 	}
 
+	a_ssd1306_shadow_invalidate(
+		handle); /* the chip ram must be rewritten after scrolling */
+
 	return a_ssd1306_write_byte(handle, SSD1306_CMD_DEACTIVATE_SCROLL,
 				    SSD1306_CMD); /* write command */
 }
@@ -2482,6 +6087,7 @@ uint8_t ssd1306_write_cmd(ssd1306_handle_t *handle, uint8_t *buf, uint8_t len)
 	{
 		return 3; /* return error */
 	}
+	handle->addressing_mode = 0xFF; /* addressing mode may be changed */
 
 	return a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, len,
 					     SSD1306_CMD); /* write command */
@@ -2509,11 +6115,55 @@ uint8_t ssd1306_write_data(ssd1306_handle_t *handle, uint8_t *buf, uint8_t len)
 	{
 		return 3; /* return error */
 	}
+	a_ssd1306_set_dirty_all(handle, 1); /* the chip ram is changed */
+	a_ssd1306_shadow_invalidate(handle); /* the shadow is changed */
 
 	return a_ssd1306_multiple_write_byte(handle, (uint8_t *)buf, len,
 					     SSD1306_DATA); /* write data */
 }
 
+/**
+ * @brief     write the register command and data in one transaction
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *cmd points to a command buffer
+ * @param[in] cmd_len is the command length
+ * @param[in] *data points to a data buffer
+ * @param[in] data_len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      on iic the commands are sent with the co bit set followed by
+ *            the data, more than 8 commands, more than 128 data bytes or spi
+ *            use two transactions
+ */
+uint8_t ssd1306_write_mixed(ssd1306_handle_t *handle, uint8_t *cmd,
+			    uint8_t cmd_len, uint8_t *data, uint8_t data_len)
+{
+	if (handle == NULL) /* check handle */
+	{
+		return 2; /* return error */
+	}
+	if (handle->inited != 1) /* check handle initialization */
+	{
+		return 3; /* return error */
+	}
+	if (cmd_len != 0) /* if command */
+	{
+		handle->addressing_mode =
+			0xFF; /* addressing mode may be changed */
+	}
+	if (data_len != 0) /* if data */
+	{
+		a_ssd1306_set_dirty_all(handle, 1); /* the chip ram is changed */
+		a_ssd1306_shadow_invalidate(handle); /* the shadow is changed */
+	}
+
+	return a_ssd1306_mixed_write(handle, cmd, cmd_len, data,
+				     data_len); /* write the message */
+}
+
 /**
  * @brief      get chip's information
  * @param[out] *info points to an ssd1306 info structure
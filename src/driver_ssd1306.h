@@ -57,6 +57,93 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief ssd1306 shadow buffer definition
+ * @note  1 keeps a copy of the chip ram in the handle for ssd1306_gram_update_diff
+ */
+#ifndef SSD1306_SHADOW_BUFFER
+    #define SSD1306_SHADOW_BUFFER    0        /**< disable the shadow buffer */
+#endif
+
+/**
+ * @brief ssd1306 gram layout definition
+ * @note  1 stores the gram as gram[page][column] so a page or the frame can be sent straight from the handle,
+ *        0 keeps the gram[column][page] layout
+ */
+#ifndef SSD1306_GRAM_PAGE_MAJOR
+    #define SSD1306_GRAM_PAGE_MAJOR    0        /**< column major gram */
+#endif
+
+/**
+ * @brief ssd1306 double buffer definition
+ * @note  1 draws into a back buffer and flushes a front buffer, ssd1306_swap_buffers publishes the drawn frame
+ */
+#ifndef SSD1306_DOUBLE_BUFFER
+    #define SSD1306_DOUBLE_BUFFER    0        /**< disable the double buffer */
+#endif
+
+/**
+ * @brief ssd1306 async flush definition
+ * @note  1 adds a gram snapshot and the async_write and async_poll hooks to the handle
+ */
+#ifndef SSD1306_ASYNC_FLUSH
+    #define SSD1306_ASYNC_FLUSH    0        /**< disable the async flush */
+#endif
+
+/**
+ * @brief ssd1306 3-wire spi definition
+ * @note  1 enables SSD1306_INTERFACE_SPI_3WIRE, which packs 9-bit words into bytes and needs no command data gpio
+ */
+#ifndef SSD1306_SPI_3WIRE
+    #define SSD1306_SPI_3WIRE    0        /**< disable the 3-wire spi */
+#endif
+
+/**
+ * @brief ssd1306 command batch size definition
+ * @note  the size must not be greater than 255
+ */
+#ifndef SSD1306_COMMAND_BATCH_SIZE
+    #define SSD1306_COMMAND_BATCH_SIZE    64        /**< 64 command bytes */
+#endif
+
+/**
+ * @brief ssd1306 glyph cache size definition
+ * @note  0 disables the cache, each entry keeps 48 shifted page bytes of one glyph at one row offset
+ */
+#ifndef SSD1306_GLYPH_CACHE_SIZE
+    #define SSD1306_GLYPH_CACHE_SIZE    0        /**< disable the glyph cache */
+#endif
+
+/**
+ * @brief ssd1306 stats definition
+ * @note  1 adds the bus and flush counters and the timestamp_us hook to the handle
+ */
+#ifndef SSD1306_STATS
+    #define SSD1306_STATS    0        /**< disable the stats */
+#endif
+
+/**
+ * @brief ssd1306 trace size definition
+ * @note  0 disables the trace, otherwise the handle keeps the last transport calls in a ring of this many entries,
+ *        a power of 2 keeps the slot index a mask
+ */
+#ifndef SSD1306_TRACE_SIZE
+    #define SSD1306_TRACE_SIZE    0        /**< disable the trace */
+#endif
+
+/**
+ * @brief ssd1306 trace head definition
+ */
+#define SSD1306_TRACE_HEAD    4        /**< first message bytes kept in a trace entry */
+
+/**
+ * @brief ssd1306 polygon max point definition
+ * @note  the polygon fill keeps one crossing per edge on the stack
+ */
+#ifndef SSD1306_POLYGON_MAX_POINT
+    #define SSD1306_POLYGON_MAX_POINT    16        /**< 16 points */
+#endif
+
 /**
  * @brief ssd1306 interface enumeration definition
  */
@@ -64,6 +151,7 @@ typedef enum
 {
     SSD1306_INTERFACE_IIC = 0x00,        /**< interface iic */
     SSD1306_INTERFACE_SPI = 0x01,        /**< interface spi */
+    SSD1306_INTERFACE_SPI_3WIRE = 0x02,  /**< interface 3-wire spi */
 } ssd1306_interface_t;
 
 /**
@@ -211,6 +299,86 @@ typedef enum
     SSD1306_FONT_24 = 0x18,        /**< font 24 */
 } ssd1306_font_t;
 
+/**
+ * @brief ssd1306 bitmap format enumeration definition
+ */
+typedef enum
+{
+    SSD1306_BITMAP_FORMAT_ROW_MAJOR = 0x00,         /**< (width + 7) / 8 bytes per row, the msb is the left pixel */
+    SSD1306_BITMAP_FORMAT_PAGE_MAJOR = 0x01,        /**< width bytes per 8 rows, the lsb is the top pixel */
+} ssd1306_bitmap_format_t;
+
+/**
+ * @brief ssd1306 point structure definition
+ */
+typedef struct ssd1306_point_s
+{
+    int16_t x;        /**< coordinate x */
+    int16_t y;        /**< coordinate y */
+} ssd1306_point_t;
+
+/**
+ * @brief ssd1306 flush mode enumeration definition
+ */
+typedef enum
+{
+    SSD1306_FLUSH_MODE_PAGE = 0x00,        /**< one addressing and one data burst per page, a full spi update is sent as a frame */
+    SSD1306_FLUSH_MODE_BYTE = 0x01,        /**< one transaction per byte */
+    SSD1306_FLUSH_MODE_FRAME = 0x02,       /**< one addressing and one data burst per frame */
+} ssd1306_flush_mode_t;
+
+/**
+ * @brief ssd1306 iic transport enumeration definition
+ */
+typedef enum
+{
+    SSD1306_IIC_TRANSPORT_SEPARATE = 0x00,            /**< addressing commands and data in separate transactions */
+    SSD1306_IIC_TRANSPORT_CONTINUATION = 0x01,        /**< addressing commands with the co bit and data in one transaction */
+} ssd1306_iic_transport_t;
+
+#if (SSD1306_GLYPH_CACHE_SIZE > 0)
+/**
+ * @brief ssd1306 glyph cache structure definition
+ */
+typedef struct ssd1306_glyph_cache_s
+{
+    const uint8_t *glyph;        /**< glyph columns in the font table */
+    uint8_t shift;               /**< row offset inside the page */
+    uint8_t mode;                /**< display mode */
+    uint8_t page[4][12];         /**< shifted page bytes */
+} ssd1306_glyph_cache_t;
+#endif
+
+#if (SSD1306_STATS == 1)
+/**
+ * @brief ssd1306 stats structure definition
+ */
+typedef struct ssd1306_stats_s
+{
+    uint32_t command_transaction;        /**< transport calls with commands only */
+    uint32_t data_transaction;           /**< transport calls with gram data */
+    uint32_t byte;                       /**< bytes sent including the iic control bytes */
+    uint32_t error;                      /**< failed transport calls */
+    uint32_t flush;                      /**< gram flushes */
+    uint64_t flush_us;                   /**< cumulative flush latency in us */
+    uint32_t flush_us_max;               /**< max flush latency in us */
+} ssd1306_stats_t;
+#endif
+
+#if (SSD1306_TRACE_SIZE > 0)
+/**
+ * @brief ssd1306 trace entry structure definition
+ */
+typedef struct ssd1306_trace_entry_s
+{
+    uint32_t timestamp_us;                  /**< call time in us, 0 without a linked timestamp_us */
+    uint16_t len;                           /**< message length without the iic control bytes */
+    uint8_t kind;                           /**< 0 commands only, 1 with gram data */
+    uint8_t res;                            /**< transport result */
+    uint8_t head[SSD1306_TRACE_HEAD];       /**< first message bytes, commands first */
+} ssd1306_trace_entry_t;
+#endif
+
 /**
  * @brief ssd1306 handle structure definition
  */
@@ -219,9 +387,11 @@ typedef struct ssd1306_handle_s
     uint8_t (*iic_init)(void);                                                          /**< point to an iic_init function address */
     uint8_t (*iic_deinit)(void);                                                        /**< point to an iic_deinit function address */
     uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
+    uint8_t (*iic_write_headroom)(uint8_t addr, uint8_t *buf, uint16_t len);            /**< point to an iic_write_headroom function address */
     uint8_t (*spi_init)(void);                                                          /**< point to a spi_init function address */
     uint8_t (*spi_deinit)(void);                                                        /**< point to a spi_deinit function address */
     uint8_t (*spi_write_cmd)(uint8_t *buf, uint16_t len);                               /**< point to a spi_write_cmd function address */
+    uint8_t (*spi_write_batch)(uint8_t **buf, uint16_t *len, uint8_t num);              /**< point to a spi_write_batch function address */
     uint8_t (*spi_cmd_data_gpio_init)(void);                                            /**< point to a spi_cmd_data_gpio_init function address */
     uint8_t (*spi_cmd_data_gpio_deinit)(void);                                          /**< point to a spi_cmd_data_gpio_deinit function address */
     uint8_t (*spi_cmd_data_gpio_write)(uint8_t value);                                  /**< point to a spi_cmd_data_gpio_write function address */
@@ -230,10 +400,85 @@ typedef struct ssd1306_handle_s
     uint8_t (*reset_gpio_write)(uint8_t value);                                         /**< point to a reset_gpio_write function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
+#if ((SSD1306_STATS == 1) || (SSD1306_TRACE_SIZE > 0))
+    uint32_t (*timestamp_us)(void);                                                     /**< point to a timestamp_us function address */
+#endif
+    uint8_t (*bus_set_speed)(uint8_t interface, uint32_t hz);                           /**< point to a bus_set_speed function address */
+    uint8_t (*bus_read_back)(uint8_t *buf, uint16_t len);                               /**< point to a bus_read_back function address */
+#if (SSD1306_ASYNC_FLUSH == 1)
+    uint8_t (*async_write)(uint8_t interface, uint8_t addr, uint8_t *cmd, uint16_t cmd_len,
+                           uint8_t *data, uint16_t data_len);                           /**< point to an async_write function address */
+    uint8_t (*async_poll)(uint8_t *busy);                                               /**< point to an async_poll function address */
+    void (*async_callback)(uint8_t res);                                                /**< point to an async callback function address */
+#endif
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t iic_addr;                                                                   /**< iic address */
     uint8_t iic_spi;                                                                    /**< iic spi type */
-    uint8_t gram[128][8];                                                               /**< gram buffer */
+    uint8_t flush_mode;                                                                 /**< flush mode */
+    uint8_t iic_transport;                                                              /**< iic transport */
+    uint32_t bus_speed;                                                                 /**< bus clock in hz, 0 is the interface default */
+    uint8_t addressing_mode;                                                            /**< memory addressing mode sent to the chip */
+    uint8_t dc_level;                                                                   /**< spi command data level, 0xFF is unknown */
+    uint8_t dirty_start[8];                                                             /**< first dirty column of each page */
+    uint8_t dirty_end[8];                                                               /**< last dirty column of each page */
+    uint8_t batch_enable;                                                               /**< command batch flag */
+    uint8_t batch_len;                                                                  /**< queued command length */
+    uint8_t batch_buf[SSD1306_COMMAND_BATCH_SIZE];                                      /**< queued command buffer */
+#if (SSD1306_GLYPH_CACHE_SIZE > 0)
+    uint8_t glyph_cache_next;                                                           /**< next glyph cache entry to replace */
+    ssd1306_glyph_cache_t glyph_cache[SSD1306_GLYPH_CACHE_SIZE];                        /**< glyph cache */
+#endif
+#if (SSD1306_SPI_3WIRE == 1)
+    uint8_t spi_3wire_buf[1170];                                                        /**< packed 3-wire words, 130 blocks of 8 words */
+    uint8_t spi_3wire_batch;                                                            /**< spi batch flag */
+    uint8_t spi_3wire_seg_num;                                                          /**< queued segment number */
+    uint16_t spi_3wire_seg_end[16];                                                     /**< queued segment end offsets */
+#endif
+#if (SSD1306_ASYNC_FLUSH == 1)
+    uint8_t async_busy;                                                                 /**< async flush busy flag */
+    uint8_t async_done;                                                                 /**< async result not reported flag */
+    uint8_t async_res;                                                                  /**< async flush result */
+    uint8_t async_cmd[8];                                                               /**< async addressing commands */
+#if (SSD1306_DOUBLE_BUFFER != 1)
+    uint8_t async_buf[1 + 1024];                                                        /**< control byte headroom and async gram snapshot */
+#endif
+#endif
+#if (SSD1306_STATS == 1)
+    ssd1306_stats_t stats;                                                              /**< bus and flush counters */
+#if (SSD1306_SPI_3WIRE == 1)
+    uint16_t spi_3wire_seg_data;                                                        /**< queued segments with gram data */
+#endif
+#if (SSD1306_ASYNC_FLUSH == 1)
+    uint32_t async_start;                                                               /**< async flush start time */
+#endif
+#endif
+#if (SSD1306_TRACE_SIZE > 0)
+    volatile uint32_t trace_count;                                                      /**< recorded transport calls */
+    ssd1306_trace_entry_t trace[SSD1306_TRACE_SIZE];                                    /**< trace ring */
+#endif
+#if (SSD1306_GRAM_PAGE_MAJOR == 1)
+#if (SSD1306_SHADOW_BUFFER == 1)
+    uint8_t shadow_valid;                                                               /**< shadow valid flag */
+    uint8_t shadow[8][128];                                                             /**< copy of the chip ram */
+#endif
+#if (SSD1306_DOUBLE_BUFFER == 1)
+    uint8_t front;                                                                      /**< index of the flushing buffer, the other one is drawn */
+    uint8_t buffer[2][1 + 1024];                                                        /**< double buffer, each with a control byte headroom */
+#else
+    uint8_t frame[1 + 1024];                                                            /**< control byte headroom and the gram */
+#endif
+#else
+#if (SSD1306_SHADOW_BUFFER == 1)
+    uint8_t shadow_valid;                                                               /**< shadow valid flag */
+    uint8_t shadow[128][8];                                                             /**< copy of the chip ram */
+#endif
+#if (SSD1306_DOUBLE_BUFFER == 1)
+    uint8_t front;                                                                      /**< index of the flushing buffer, the other one is drawn */
+    uint8_t buffer[2][1 + 1024];                                                        /**< double buffer, each with a control byte headroom */
+#else
+    uint8_t frame[1 + 1024];                                                            /**< control byte headroom and the gram */
+#endif
+#endif
 } ssd1306_handle_t;
 
 /**
@@ -295,6 +540,14 @@ typedef struct ssd1306_info_s
  */
 #define DRIVER_SSD1306_LINK_IIC_WRITE(HANDLE, FUC)                     (HANDLE)->iic_write = FUC
 
+/**
+ * @brief     link iic_write_headroom function
+ * @param[in] HANDLE points to an ssd1306 handle structure
+ * @param[in] FUC points to an iic_write_headroom function address
+ * @note      optional, buf[0] already holds the control byte and the whole buffer is sent as it is
+ */
+#define DRIVER_SSD1306_LINK_IIC_WRITE_HEADROOM(HANDLE, FUC)            (HANDLE)->iic_write_headroom = FUC
+
 /**
  * @brief     link spi_init function
  * @param[in] HANDLE points to an ssd1306 handle structure
@@ -319,6 +572,14 @@ typedef struct ssd1306_info_s
  */
 #define DRIVER_SSD1306_LINK_SPI_WRITE_COMMAND(HANDLE, FUC)             (HANDLE)->spi_write_cmd = FUC
 
+/**
+ * @brief     link spi_write_batch function
+ * @param[in] HANDLE points to an ssd1306 handle structure
+ * @param[in] FUC points to a spi_write_batch function address
+ * @note      optional, it sends all segments in one submission with cs released between them
+ */
+#define DRIVER_SSD1306_LINK_SPI_WRITE_BATCH(HANDLE, FUC)               (HANDLE)->spi_write_batch = FUC
+
 /**
  * @brief     link spi_cmd_data_gpio_init function
  * @param[in] HANDLE points to an ssd1306 handle structure
@@ -383,6 +644,51 @@ typedef struct ssd1306_info_s
  */
 #define DRIVER_SSD1306_LINK_DEBUG_PRINT(HANDLE, FUC)                   (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link bus_set_speed function
+ * @param[in] HANDLE points to an ssd1306 handle structure
+ * @param[in] FUC points to a bus_set_speed function address
+ * @note      optional, it changes the clock of the bus in use
+ */
+#define DRIVER_SSD1306_LINK_BUS_SET_SPEED(HANDLE, FUC)                 (HANDLE)->bus_set_speed = FUC
+
+/**
+ * @brief     link bus_read_back function
+ * @param[in] HANDLE points to an ssd1306 handle structure
+ * @param[in] FUC points to a bus_read_back function address
+ * @note      optional, it returns the last bytes echoed by a loopback bus
+ */
+#define DRIVER_SSD1306_LINK_BUS_READ_BACK(HANDLE, FUC)                 (HANDLE)->bus_read_back = FUC
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+/**
+ * @brief     link async_write function
+ * @param[in] HANDLE points to an ssd1306 handle structure
+ * @param[in] FUC points to an async_write function address
+ * @note      optional, it starts the command and data transfer and returns at once,
+ *            the byte before the data is a writable headroom for the iic control byte
+ */
+#define DRIVER_SSD1306_LINK_ASYNC_WRITE(HANDLE, FUC)                   (HANDLE)->async_write = FUC
+
+/**
+ * @brief     link async_poll function
+ * @param[in] HANDLE points to an ssd1306 handle structure
+ * @param[in] FUC points to an async_poll function address
+ * @note      optional, it reports whether the started transfer is still running
+ */
+#define DRIVER_SSD1306_LINK_ASYNC_POLL(HANDLE, FUC)                    (HANDLE)->async_poll = FUC
+#endif
+
+#if ((SSD1306_STATS == 1) || (SSD1306_TRACE_SIZE > 0))
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE points to an ssd1306 handle structure
+ * @param[in] FUC points to a timestamp_us function address
+ * @note      optional, it returns a monotonic time in us for the flush latency and the trace
+ */
+#define DRIVER_SSD1306_LINK_TIMESTAMP_US(HANDLE, FUC)                  (HANDLE)->timestamp_us = FUC
+#endif
+
 /**
  * @}
  */
@@ -448,6 +754,120 @@ uint8_t ssd1306_set_addr_pin(ssd1306_handle_t *handle, ssd1306_address_t addr_pi
  */
 uint8_t ssd1306_get_addr_pin(ssd1306_handle_t *handle, ssd1306_address_t *addr_pin);
 
+/**
+ * @brief     set the gram flush mode
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] mode is the flush mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t ssd1306_set_flush_mode(ssd1306_handle_t *handle, ssd1306_flush_mode_t mode);
+
+/**
+ * @brief      get the gram flush mode
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *mode points to a flush mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1306_get_flush_mode(ssd1306_handle_t *handle, ssd1306_flush_mode_t *mode);
+
+/**
+ * @brief     set the iic transport
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] transport is the iic transport
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the continuation transport sends each page write as one iic message
+ */
+uint8_t ssd1306_set_iic_transport(ssd1306_handle_t *handle, ssd1306_iic_transport_t transport);
+
+/**
+ * @brief      get the iic transport
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *transport points to an iic transport buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ssd1306_get_iic_transport(ssd1306_handle_t *handle, ssd1306_iic_transport_t *transport);
+
+/**
+ * @brief     set the bus clock
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] hz is the bus clock in hz
+ * @return    status code
+ *            - 0 success
+ *            - 1 set bus speed failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 bus speed is not supported
+ * @note      none
+ */
+uint8_t ssd1306_set_bus_speed(ssd1306_handle_t *handle, uint32_t hz);
+
+/**
+ * @brief      get the bus clock
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *hz points to a bus clock buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       0 means the interface default clock
+ */
+uint8_t ssd1306_get_bus_speed(ssd1306_handle_t *handle, uint32_t *hz);
+
+/**
+ * @brief      probe the fastest stable bus clock
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[in]  *rate points to a rising bus clock list in hz
+ * @param[in]  num is the list length
+ * @param[out] *hz points to a bus clock buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no clock is stable
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 bus speed is not supported
+ *             - 5 rate list is invalid
+ *             - 6 the current bus speed is unknown
+ * @note       a test pattern frame is written at each clock until a write fails or the
+ *             bus_read_back echo differs, the fastest stable clock stays set and the gram
+ *             is written again, the clock set by ssd1306_set_bus_speed is the fallback and
+ *             it is restored if no clock is stable
+ */
+uint8_t ssd1306_probe_bus_speed(ssd1306_handle_t *handle, const uint32_t *rate, uint8_t num, uint32_t *hz);
+
+/**
+ * @brief     begin a command batch
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the commands of the following calls are queued in the handle
+ *            until ssd1306_command_batch_commit or the next data write
+ */
+uint8_t ssd1306_command_batch_begin(ssd1306_handle_t *handle);
+
+/**
+ * @brief     commit a command batch
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 commit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      all queued commands are sent in one transaction
+ */
+uint8_t ssd1306_command_batch_commit(ssd1306_handle_t *handle);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle points to an ssd1306 handle structure
@@ -503,6 +923,160 @@ uint8_t ssd1306_clear(ssd1306_handle_t *handle);
  */
 uint8_t ssd1306_gram_update(ssd1306_handle_t *handle);
 
+/**
+ * @brief     update the dirty ranges of the gram data
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      only the columns changed since the last update are sent
+ */
+uint8_t ssd1306_gram_update_dirty(ssd1306_handle_t *handle);
+
+/**
+ * @brief     update the gram data by comparing it with the shadow buffer
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      only the changed column runs are sent and the whole gram is sent
+ *            while the shadow is not valid, runs closer than the cost of new
+ *            addressing on the current interface, transport and flush mode
+ *            are merged, without SSD1306_SHADOW_BUFFER it works as
+ *            ssd1306_gram_update_dirty
+ */
+uint8_t ssd1306_gram_update_diff(ssd1306_handle_t *handle);
+
+/**
+ * @brief     start an asynchronous gram update
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *callback points to a completion callback, it can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram update async failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 async is not supported
+ *            - 5 the last update is still running
+ * @note      the gram is copied before this function returns, so drawing can
+ *            go on while the transfer runs, the result and the callback are
+ *            reported only by ssd1306_gram_update_async_poll or
+ *            ssd1306_gram_update_async_wait, other driver calls wait for the
+ *            transfer and keep the result, a result that is not reported
+ *            before the next update starts is dropped
+ */
+uint8_t ssd1306_gram_update_async(ssd1306_handle_t *handle, void (*callback)(uint8_t res));
+
+/**
+ * @brief      poll the asynchronous gram update
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *busy points to a busy flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the finished transfer failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the callback runs here once the transfer is found finished, also
+ *             when another driver call waited for it before
+ */
+uint8_t ssd1306_gram_update_async_poll(ssd1306_handle_t *handle, uint8_t *busy);
+
+/**
+ * @brief     wait for the asynchronous gram update
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 the finished transfer failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback runs here once the transfer is over
+ */
+uint8_t ssd1306_gram_update_async_wait(ssd1306_handle_t *handle);
+
+/**
+ * @brief     swap the front and back buffers
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 double buffer is not supported
+ *            - 5 an async update is still reading the front buffer
+ * @note      the drawn back buffer becomes the front buffer for the next
+ *            update and drawing goes on in the old front buffer, so each
+ *            frame is drawn in full or compared with the shadow buffer
+ */
+uint8_t ssd1306_swap_buffers(ssd1306_handle_t *handle);
+
+#if (SSD1306_STATS == 1)
+/**
+ * @brief      get the stats
+ * @param[in]  *handle points to an ssd1306 handle structure
+ * @param[out] *stats points to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the flush latency is only counted with a linked timestamp_us,
+ *             an async flush is timed from its start to its completion
+ */
+uint8_t ssd1306_get_stats(ssd1306_handle_t *handle, ssd1306_stats_t *stats);
+
+/**
+ * @brief     reset the stats
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ssd1306_init resets the stats too
+ */
+uint8_t ssd1306_reset_stats(ssd1306_handle_t *handle);
+#endif
+
+#if (SSD1306_TRACE_SIZE > 0)
+/**
+ * @brief         get the trace
+ * @param[in]     *handle points to an ssd1306 handle structure
+ * @param[out]    *entry points to a trace entry buffer
+ * @param[in,out] *num points to the buffer entry number and returns the copied entry number
+ * @param[out]    *count points to a buffer of all recorded calls since the last clear
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the newest entries are copied oldest first, entries overwritten by the driver
+ *                while they are copied are dropped, so it can run beside the driver without a lock
+ */
+uint8_t ssd1306_get_trace(ssd1306_handle_t *handle, ssd1306_trace_entry_t *entry, uint16_t *num, uint32_t *count);
+
+/**
+ * @brief     print the trace
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the entries are printed oldest first through debug_print
+ */
+uint8_t ssd1306_print_trace(ssd1306_handle_t *handle);
+
+/**
+ * @brief     clear the trace
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      ssd1306_init clears the trace too
+ */
+uint8_t ssd1306_clear_trace(ssd1306_handle_t *handle);
+#endif
+
 /**
  * @brief     write a point
  * @param[in] *handle points to an ssd1306 handle structure
@@ -519,6 +1093,25 @@ uint8_t ssd1306_gram_update(ssd1306_handle_t *handle);
  */
 uint8_t ssd1306_write_point(ssd1306_handle_t *handle, uint8_t x, uint8_t y, uint8_t data);
 
+/**
+ * @brief     write a group of points
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *point points to a point buffer
+ * @param[in] num is the point number
+ * @param[in] data is the write data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write points failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 point is NULL or num is 0
+ *            - 5 x or y is invalid
+ * @note      the points are grouped by page and column and each run of
+ *            adjacent columns is sent with one addressing sequence and one
+ *            data burst
+ */
+uint8_t ssd1306_write_points(ssd1306_handle_t *handle, const ssd1306_point_t *point, uint16_t num, uint8_t data);
+
 /**
  * @brief      read a point
  * @param[in]  *handle points to an ssd1306 handle structure
@@ -602,7 +1195,7 @@ uint8_t ssd1306_gram_write_string(ssd1306_handle_t *handle, uint8_t x, uint8_t y
  *            - 4 left or top is invalid
  *            - 5 right or bottom is invalid
  *            - 6 left > right or top > bottom
- * @note      none
+ * @note      each page is filled as one masked column span
  */
 uint8_t ssd1306_gram_fill_rect(ssd1306_handle_t *handle, uint8_t left, uint8_t top, uint8_t right, uint8_t bottom, uint8_t color);
 
@@ -626,6 +1219,150 @@ uint8_t ssd1306_gram_fill_rect(ssd1306_handle_t *handle, uint8_t left, uint8_t t
  */
 uint8_t ssd1306_gram_draw_picture(ssd1306_handle_t *handle, uint8_t left, uint8_t top, uint8_t right, uint8_t bottom, uint8_t *img);
 
+/**
+ * @brief     draw a packed 1bpp bitmap in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the left coordinate x
+ * @param[in] y is the top coordinate y
+ * @param[in] width is the bitmap width
+ * @param[in] height is the bitmap height
+ * @param[in] *bitmap points to a bitmap buffer
+ * @param[in] format is the bitmap format
+ * @return    status code
+ *            - 0 success
+ *            - 1 gram draw bitmap failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 x or y is invalid
+ *            - 5 width or height is invalid
+ *            - 6 format is invalid
+ * @note      a page-major bitmap at a page aligned y is copied row by row
+ */
+uint8_t ssd1306_gram_draw_bitmap(ssd1306_handle_t *handle, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                                 const uint8_t *bitmap, ssd1306_bitmap_format_t format);
+
+/**
+ * @brief     draw a line in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x0 is the start coordinate x
+ * @param[in] y0 is the start coordinate y
+ * @param[in] x1 is the end coordinate x
+ * @param[in] y1 is the end coordinate y
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the line is clipped to the screen
+ */
+uint8_t ssd1306_gram_draw_line(ssd1306_handle_t *handle, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
+
+/**
+ * @brief     draw a circle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the center coordinate x
+ * @param[in] y is the center coordinate y
+ * @param[in] r is the radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the circle is clipped to the screen
+ */
+uint8_t ssd1306_gram_draw_circle(ssd1306_handle_t *handle, int16_t x, int16_t y, uint8_t r, uint8_t color);
+
+/**
+ * @brief     fill a circle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the center coordinate x
+ * @param[in] y is the center coordinate y
+ * @param[in] r is the radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the circle is clipped to the screen
+ */
+uint8_t ssd1306_gram_fill_circle(ssd1306_handle_t *handle, int16_t x, int16_t y, uint8_t r, uint8_t color);
+
+/**
+ * @brief     draw an arc in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] x is the center coordinate x
+ * @param[in] y is the center coordinate y
+ * @param[in] r is the radius
+ * @param[in] start is the start angle in degree
+ * @param[in] end is the end angle in degree
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 start or end is invalid
+ * @note      0 degree points to the right and the angle grows clockwise on the screen,
+ *            the arc runs clockwise from start to end and start == end draws the whole circle
+ */
+uint8_t ssd1306_gram_draw_arc(ssd1306_handle_t *handle, int16_t x, int16_t y, uint8_t r,
+                              uint16_t start, uint16_t end, uint8_t color);
+
+/**
+ * @brief     draw a rounded rectangle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] r is the corner radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 left > right or top > bottom
+ *            - 5 r is invalid
+ * @note      the rectangle is clipped to the screen
+ */
+uint8_t ssd1306_gram_draw_round_rect(ssd1306_handle_t *handle, int16_t left, int16_t top, int16_t right, int16_t bottom,
+                                     uint8_t r, uint8_t color);
+
+/**
+ * @brief     fill a rounded rectangle in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] left is the left coordinate x
+ * @param[in] top is the top coordinate y
+ * @param[in] right is the right coordinate x
+ * @param[in] bottom is the bottom coordinate y
+ * @param[in] r is the corner radius
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 left > right or top > bottom
+ *            - 5 r is invalid
+ * @note      the rectangle is clipped to the screen
+ */
+uint8_t ssd1306_gram_fill_round_rect(ssd1306_handle_t *handle, int16_t left, int16_t top, int16_t right, int16_t bottom,
+                                     uint8_t r, uint8_t color);
+
+/**
+ * @brief     fill a polygon in the gram
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *point points to a vertex buffer
+ * @param[in] num is the vertex number
+ * @param[in] color is the display color
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 point or num is invalid
+ * @note      rows are filled by the even-odd rule at the row of each pixel,
+ *            num must be in range of 3 to SSD1306_POLYGON_MAX_POINT
+ */
+uint8_t ssd1306_gram_fill_polygon(ssd1306_handle_t *handle, const ssd1306_point_t *point, uint8_t num, uint8_t color);
+
 /**
  * @brief     set the low column start address
  * @param[in] *handle points to an ssd1306 handle structure
@@ -1090,6 +1827,24 @@ uint8_t ssd1306_write_cmd(ssd1306_handle_t *handle, uint8_t *buf, uint8_t len);
  */
 uint8_t ssd1306_write_data(ssd1306_handle_t *handle, uint8_t *buf, uint8_t len);
 
+/**
+ * @brief     write the register command and data in one transaction
+ * @param[in] *handle points to an ssd1306 handle structure
+ * @param[in] *cmd points to a command buffer
+ * @param[in] cmd_len is the command length
+ * @param[in] *data points to a data buffer
+ * @param[in] data_len is the data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      on iic the commands are sent with the co bit set followed by the data,
+ *            more than 8 commands, more than 128 data bytes or spi use two transactions
+ */
+uint8_t ssd1306_write_mixed(ssd1306_handle_t *handle, uint8_t *cmd, uint8_t cmd_len,
+                            uint8_t *data, uint8_t data_len);
+
 /**
  * @}
  */
@@ -0,0 +1,1047 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ssd1306_flush_test.c
+ * @brief     driver ssd1306 flush test source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/30  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/12/10  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ssd1306_flush_test.h"
+
+static ssd1306_handle_t gs_handle;        /**< ssd1306 handle */
+static uint32_t gs_transaction;           /**< bus transaction counter */
+static uint32_t gs_byte;                  /**< bus byte counter */
+static uint32_t gs_gpio;                  /**< command data gpio write counter */
+#if (SSD1306_ASYNC_FLUSH == 1)
+static volatile uint8_t gs_async_flag;    /**< async callback flag */
+static volatile uint8_t gs_async_res;     /**< async callback result */
+#endif
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr is the iic device write address
+ * @param[in] reg is the iic register address
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the address and control bytes are counted with the payload
+ */
+static uint8_t a_ssd1306_flush_test_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_transaction++;
+    gs_byte += (uint32_t)len + 2;
+
+    return ssd1306_interface_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting iic bus write with headroom
+ * @param[in] addr is the iic device write address
+ * @param[in] *buf points to a data buffer starting with the control byte
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the address byte is counted with the buffer
+ */
+static uint8_t a_ssd1306_flush_test_iic_write_headroom(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    gs_transaction++;
+    gs_byte += (uint32_t)len + 1;
+
+    return ssd1306_interface_iic_write_headroom(addr, buf, len);
+}
+
+/**
+ * @brief     counting spi bus write
+ * @param[in] *buf points to a data buffer
+ * @param[in] len is the length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_flush_test_spi_write(uint8_t *buf, uint16_t len)
+{
+    gs_transaction++;
+    gs_byte += len;
+
+    return ssd1306_interface_spi_write_cmd(buf, len);
+}
+
+/**
+ * @brief     counting spi bus write batch
+ * @param[in] **buf points to the segment buffers
+ * @param[in] *len points to the segment lengths
+ * @param[in] num is the segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one batch is counted as one transaction
+ */
+static uint8_t a_ssd1306_flush_test_spi_write_batch(uint8_t **buf, uint16_t *len, uint8_t num)
+{
+    uint8_t i;
+
+    gs_transaction++;
+    for (i = 0; i < num; i++)
+    {
+        gs_byte += len[i];
+    }
+
+    return ssd1306_interface_spi_write_batch(buf, len, num);
+}
+
+/**
+ * @brief     counting spi command data gpio write
+ * @param[in] value is the written value
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio write failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_flush_test_gpio_write(uint8_t value)
+{
+    gs_gpio++;
+
+    return ssd1306_interface_spi_cmd_data_gpio_write(value);
+}
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+/**
+ * @brief     async flush callback
+ * @param[in] res is the transfer result
+ * @note      none
+ */
+static void a_ssd1306_flush_test_async_callback(uint8_t res)
+{
+    gs_async_res = res;
+    gs_async_flag = 1;
+}
+
+/**
+ * @brief  run and measure one async frame flush
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_ssd1306_flush_test_async(void)
+{
+    uint8_t res;
+    uint8_t busy;
+    uint8_t i;
+    uint32_t poll;
+
+    /* draw a frame */
+    for (i = 0; i < 128; i++)
+    {
+        res = ssd1306_gram_write_point(&gs_handle, i, (uint8_t)(i / 2), 1);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram write point failed.\n");
+
+            return 1;
+        }
+    }
+
+    /* start the async update */
+    gs_async_flag = 0;
+    res = ssd1306_gram_update_async(&gs_handle, a_ssd1306_flush_test_async_callback);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update async failed.\n");
+
+        return 1;
+    }
+
+    /* draw the next frame while the transfer runs */
+    for (i = 0; i < 128; i++)
+    {
+        res = ssd1306_gram_write_point(&gs_handle, i, (uint8_t)(63 - i / 2), 1);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram write point failed.\n");
+
+            return 1;
+        }
+    }
+
+    /* a command waits for the transfer but leaves the callback to the poll */
+    res = ssd1306_set_contrast(&gs_handle, 0xCF);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set contrast failed.\n");
+
+        return 1;
+    }
+    if (gs_async_flag != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: async callback ran outside the poll.\n");
+
+        return 1;
+    }
+
+    /* poll until finished */
+    poll = 0;
+    do
+    {
+        res = ssd1306_gram_update_async_poll(&gs_handle, &busy);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram update async poll failed.\n");
+
+            return 1;
+        }
+        poll++;
+    } while (busy != 0);
+    if ((gs_async_flag != 1) || (gs_async_res != 0))
+    {
+        ssd1306_interface_debug_print("ssd1306: async callback failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: async frame finished after %d polls.\n", (int)poll);
+
+    /* show the next frame */
+    res = ssd1306_gram_update_async(&gs_handle, NULL);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update async failed.\n");
+
+        return 1;
+    }
+    res = ssd1306_gram_update_async_wait(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update async wait failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_delay_ms(1000);
+
+    return 0;
+}
+#endif
+
+#if (SSD1306_DOUBLE_BUFFER == 1)
+/**
+ * @brief  run and measure the buffer swap
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_ssd1306_flush_test_swap(void)
+{
+    uint8_t res;
+    uint8_t i, j, k;
+
+    for (k = 0; k < 4; k++)
+    {
+        /* redraw the whole back buffer */
+        for (i = 0; i < 128; i++)
+        {
+            for (j = 0; j < 64; j++)
+            {
+                res = ssd1306_gram_write_point(&gs_handle, i, j, (uint8_t)((((i + k) >> 3) ^ (j >> 3)) & 0x01));
+                if (res != 0)
+                {
+                    ssd1306_interface_debug_print("ssd1306: gram write point failed.\n");
+
+                    return 1;
+                }
+            }
+        }
+
+        /* publish the frame */
+        res = ssd1306_swap_buffers(&gs_handle);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: swap buffers failed.\n");
+
+            return 1;
+        }
+        gs_transaction = 0;
+        gs_byte = 0;
+        gs_gpio = 0;
+        res = ssd1306_gram_update_diff(&gs_handle);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram update diff failed.\n");
+
+            return 1;
+        }
+        ssd1306_interface_debug_print("ssd1306: swap frame %d used %d transactions, %d bytes and %d gpio writes.\n",
+                                      (int)k, (int)gs_transaction, (int)gs_byte, (int)gs_gpio);
+        ssd1306_interface_delay_ms(1000);
+    }
+
+    return 0;
+}
+#endif
+
+/**
+ * @brief     run and measure one frame flush
+ * @param[in] mode is the flush mode
+ * @param[in] *name points to a mode name buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_flush_test_frame(ssd1306_flush_mode_t mode, const char *name)
+{
+    uint8_t res;
+    uint8_t i, j;
+
+    /* set flush mode */
+    res = ssd1306_set_flush_mode(&gs_handle, mode);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set flush mode failed.\n");
+
+        return 1;
+    }
+
+    /* draw a checkerboard */
+    for (i = 0; i < 128; i++)
+    {
+        for (j = 0; j < 64; j++)
+        {
+            res = ssd1306_gram_write_point(&gs_handle, i, j, (uint8_t)(((i >> 3) ^ (j >> 3)) & 0x01));
+            if (res != 0)
+            {
+                ssd1306_interface_debug_print("ssd1306: gram write point failed.\n");
+
+                return 1;
+            }
+        }
+    }
+
+    /* update the frame */
+    gs_transaction = 0;
+    gs_byte = 0;
+    gs_gpio = 0;
+    res = ssd1306_gram_update(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: %s mode frame used %d transactions, %d bytes and %d gpio writes.\n",
+                                  name, (int)gs_transaction, (int)gs_byte, (int)gs_gpio);
+    ssd1306_interface_delay_ms(1000);
+
+    /* change one clock digit */
+    res = ssd1306_gram_write_string(&gs_handle, 0, 0, "12:34", 5, 1, SSD1306_FONT_16);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram write string failed.\n");
+
+        return 1;
+    }
+    res = ssd1306_gram_update(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update failed.\n");
+
+        return 1;
+    }
+    res = ssd1306_gram_write_string(&gs_handle, 0, 0, "12:35", 5, 1, SSD1306_FONT_16);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram write string failed.\n");
+
+        return 1;
+    }
+    gs_transaction = 0;
+    gs_byte = 0;
+    gs_gpio = 0;
+    res = ssd1306_gram_update_dirty(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update dirty failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: %s mode dirty update used %d transactions, %d bytes and %d gpio writes.\n",
+                                  name, (int)gs_transaction, (int)gs_byte, (int)gs_gpio);
+    ssd1306_interface_delay_ms(1000);
+
+    /* change the digit back */
+    res = ssd1306_gram_write_string(&gs_handle, 0, 0, "12:34", 5, 1, SSD1306_FONT_16);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram write string failed.\n");
+
+        return 1;
+    }
+    gs_transaction = 0;
+    gs_byte = 0;
+    gs_gpio = 0;
+    res = ssd1306_gram_update_diff(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update diff failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: %s mode diff update used %d transactions, %d bytes and %d gpio writes.\n",
+                                  name, (int)gs_transaction, (int)gs_byte, (int)gs_gpio);
+    ssd1306_interface_delay_ms(1000);
+
+    /* clear the frame */
+    gs_transaction = 0;
+    gs_byte = 0;
+    gs_gpio = 0;
+    res = ssd1306_clear(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: clear failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: %s mode clear used %d transactions, %d bytes and %d gpio writes.\n",
+                                  name, (int)gs_transaction, (int)gs_byte, (int)gs_gpio);
+    ssd1306_interface_delay_ms(1000);
+
+    return 0;
+}
+
+/**
+ * @brief  run and measure the immediate waveform plot
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_ssd1306_flush_test_points(void)
+{
+    ssd1306_point_t point[128];
+    uint8_t res;
+    uint8_t i;
+
+    /* build a triangle wave */
+    for (i = 0; i < 128; i++)
+    {
+        point[i].x = i;
+        point[i].y = (int16_t)(((i % 96) < 48) ? (8 + (i % 96)) : (103 - (i % 96)));
+    }
+
+    /* plot point by point */
+    gs_transaction = 0;
+    gs_byte = 0;
+    gs_gpio = 0;
+    for (i = 0; i < 128; i++)
+    {
+        res = ssd1306_write_point(&gs_handle, (uint8_t)point[i].x, (uint8_t)point[i].y, 1);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: write point failed.\n");
+
+            return 1;
+        }
+    }
+    ssd1306_interface_debug_print("ssd1306: write point wave used %d transactions, %d bytes and %d gpio writes.\n",
+                                  (int)gs_transaction, (int)gs_byte, (int)gs_gpio);
+    ssd1306_interface_delay_ms(1000);
+
+    /* clear the wave */
+    res = ssd1306_write_points(&gs_handle, point, 128, 0);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: write points failed.\n");
+
+        return 1;
+    }
+
+    /* plot the whole wave */
+    gs_transaction = 0;
+    gs_byte = 0;
+    gs_gpio = 0;
+    res = ssd1306_write_points(&gs_handle, point, 128, 1);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: write points failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: write points wave used %d transactions, %d bytes and %d gpio writes.\n",
+                                  (int)gs_transaction, (int)gs_byte, (int)gs_gpio);
+    ssd1306_interface_delay_ms(1000);
+
+    return 0;
+}
+
+#if (SSD1306_STATS == 1)
+/**
+ * @brief     check the stats against the counting bus
+ * @param[in] interface is the interface type
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the counting bus adds the iic address byte to every transaction
+ */
+static uint8_t a_ssd1306_flush_test_stats(ssd1306_interface_t interface)
+{
+    ssd1306_stats_t stats;
+    uint32_t byte;
+    uint8_t res;
+
+    /* reset stats */
+    res = ssd1306_reset_stats(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: reset stats failed.\n");
+
+        return 1;
+    }
+
+    /* update the frame */
+    gs_transaction = 0;
+    gs_byte = 0;
+    gs_gpio = 0;
+    res = ssd1306_gram_update(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: gram update failed.\n");
+
+        return 1;
+    }
+
+    /* get stats */
+    res = ssd1306_get_stats(&gs_handle, &stats);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: get stats failed.\n");
+
+        return 1;
+    }
+    byte = (interface == SSD1306_INTERFACE_IIC) ? (gs_byte - gs_transaction) : gs_byte;
+    ssd1306_interface_debug_print("ssd1306: stats counted %d command transactions, %d data transactions, %d bytes and %d flush in %dus.\n",
+                                  (int)stats.command_transaction, (int)stats.data_transaction, (int)stats.byte,
+                                  (int)stats.flush, (int)stats.flush_us);
+    if ((stats.command_transaction + stats.data_transaction != gs_transaction) || (stats.byte != byte) ||
+        (stats.error != 0) || (stats.flush != 1) || (stats.flush_us_max != stats.flush_us))
+    {
+        ssd1306_interface_debug_print("ssd1306: stats check failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: stats check passed.\n");
+
+    return 0;
+}
+#endif
+
+#if (SSD1306_TRACE_SIZE > 0)
+/**
+ * @brief  check the trace of a point write
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   none
+ */
+static uint8_t a_ssd1306_flush_test_trace(void)
+{
+    ssd1306_trace_entry_t entry[SSD1306_TRACE_SIZE];
+    uint16_t num;
+    uint16_t i;
+    uint32_t count;
+    uint8_t res;
+
+    /* clear trace */
+    res = ssd1306_clear_trace(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: clear trace failed.\n");
+
+        return 1;
+    }
+
+    /* write a point */
+    res = ssd1306_write_point(&gs_handle, 3, 5, 1);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: write point failed.\n");
+
+        return 1;
+    }
+
+    /* get trace */
+    num = SSD1306_TRACE_SIZE;
+    res = ssd1306_get_trace(&gs_handle, entry, &num, &count);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: get trace failed.\n");
+
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        if ((entry[i].kind != 0) && (entry[i].res == 0) && (entry[i].len != 0))
+        {
+            break;
+        }
+    }
+    if ((count == 0) || (num != ((count > SSD1306_TRACE_SIZE) ? SSD1306_TRACE_SIZE : count)) || (i == num))
+    {
+        ssd1306_interface_debug_print("ssd1306: trace check failed.\n");
+
+        return 1;
+    }
+    res = ssd1306_print_trace(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: print trace failed.\n");
+
+        return 1;
+    }
+    ssd1306_interface_debug_print("ssd1306: trace check passed.\n");
+
+    return 0;
+}
+#endif
+
+/**
+ * @brief     flush test
+ * @param[in] interface is the interface type
+ * @param[in] addr is the iic device address
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+uint8_t ssd1306_flush_test(ssd1306_interface_t interface, ssd1306_address_t addr)
+{
+    uint8_t res;
+    ssd1306_info_t info;
+
+    /* link functions */
+    DRIVER_SSD1306_LINK_INIT(&gs_handle, ssd1306_handle_t);
+    DRIVER_SSD1306_LINK_IIC_INIT(&gs_handle, ssd1306_interface_iic_init);
+    DRIVER_SSD1306_LINK_IIC_DEINIT(&gs_handle, ssd1306_interface_iic_deinit);
+    DRIVER_SSD1306_LINK_IIC_WRITE(&gs_handle, a_ssd1306_flush_test_iic_write);
+    DRIVER_SSD1306_LINK_IIC_WRITE_HEADROOM(&gs_handle, a_ssd1306_flush_test_iic_write_headroom);
+    DRIVER_SSD1306_LINK_SPI_INIT(&gs_handle, ssd1306_interface_spi_init);
+    DRIVER_SSD1306_LINK_SPI_DEINIT(&gs_handle, ssd1306_interface_spi_deinit);
+    DRIVER_SSD1306_LINK_SPI_WRITE_COMMAND(&gs_handle, a_ssd1306_flush_test_spi_write);
+    DRIVER_SSD1306_LINK_SPI_WRITE_BATCH(&gs_handle, a_ssd1306_flush_test_spi_write_batch);
+    DRIVER_SSD1306_LINK_BUS_SET_SPEED(&gs_handle, ssd1306_interface_bus_set_speed);
+    DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_INIT(&gs_handle, ssd1306_interface_spi_cmd_data_gpio_init);
+    DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_DEINIT(&gs_handle, ssd1306_interface_spi_cmd_data_gpio_deinit);
+    DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_WRITE(&gs_handle, a_ssd1306_flush_test_gpio_write);
+    DRIVER_SSD1306_LINK_RESET_GPIO_INIT(&gs_handle, ssd1306_interface_reset_gpio_init);
+    DRIVER_SSD1306_LINK_RESET_GPIO_DEINIT(&gs_handle, ssd1306_interface_reset_gpio_deinit);
+    DRIVER_SSD1306_LINK_RESET_GPIO_WRITE(&gs_handle, ssd1306_interface_reset_gpio_write);
+    DRIVER_SSD1306_LINK_DELAY_MS(&gs_handle, ssd1306_interface_delay_ms);
+    DRIVER_SSD1306_LINK_DEBUG_PRINT(&gs_handle, ssd1306_interface_debug_print);
+#if ((SSD1306_STATS == 1) || (SSD1306_TRACE_SIZE > 0))
+    DRIVER_SSD1306_LINK_TIMESTAMP_US(&gs_handle, ssd1306_interface_timestamp_us);
+#endif
+#if (SSD1306_ASYNC_FLUSH == 1)
+    DRIVER_SSD1306_LINK_ASYNC_WRITE(&gs_handle, ssd1306_interface_async_write);
+    DRIVER_SSD1306_LINK_ASYNC_POLL(&gs_handle, ssd1306_interface_async_poll);
+#endif
+
+    /* ssd1306 info */
+    res = ssd1306_info(&info);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: get info failed.\n");
+
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        ssd1306_interface_debug_print("ssd1306: chip is %s.\n", info.chip_name);
+        ssd1306_interface_debug_print("ssd1306: manufacturer is %s.\n", info.manufacturer_name);
+        ssd1306_interface_debug_print("ssd1306: interface is %s.\n", info.interface);
+        ssd1306_interface_debug_print("ssd1306: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        ssd1306_interface_debug_print("ssd1306: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ssd1306_interface_debug_print("ssd1306: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ssd1306_interface_debug_print("ssd1306: max current is %0.2fmA.\n", info.max_current_ma);
+        ssd1306_interface_debug_print("ssd1306: max temperature is %0.1fC.\n", info.temperature_max);
+        ssd1306_interface_debug_print("ssd1306: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+
+    /* set interface */
+    res = ssd1306_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set interface failed.\n");
+
+        return 1;
+    }
+
+    /* set addr pin */
+    res = ssd1306_set_addr_pin(&gs_handle, addr);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set addr failed.\n");
+
+        return 1;
+    }
+
+    /* ssd1306 init */
+    res = ssd1306_init(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: init failed.\n");
+
+        return 1;
+    }
+
+    /* close display */
+    res = ssd1306_set_display(&gs_handle, SSD1306_DISPLAY_OFF);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set display failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set display clock */
+    res = ssd1306_set_display_clock(&gs_handle, 0x08, 0x00);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set display clock failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set multiplex ratio */
+    res = ssd1306_set_multiplex_ratio(&gs_handle, 0x3F);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set multiplex ratio failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set display offset */
+    res = ssd1306_set_display_offset(&gs_handle, 0x00);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set display offset failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set display start line */
+    res = ssd1306_set_display_start_line(&gs_handle, 0x00);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set display start line failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* enable charge pump */
+    res = ssd1306_set_charge_pump(&gs_handle, SSD1306_CHARGE_PUMP_ENABLE);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set charge pump failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set page memory addressing mode */
+    res = ssd1306_set_memory_addressing_mode(&gs_handle, SSD1306_MEMORY_ADDRESSING_MODE_PAGE);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set memory addressing level failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set segment remap */
+    res = ssd1306_set_segment_remap(&gs_handle, SSD1306_SEGMENT_COLUMN_ADDRESS_127);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set segment remap failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set scan direction */
+    res = ssd1306_set_scan_direction(&gs_handle, SSD1306_SCAN_DIRECTION_COMN_1_START);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set scan direction failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set hardware pins conf */
+    res = ssd1306_set_com_pins_hardware_conf(&gs_handle, SSD1306_PIN_CONF_ALTERNATIVE, SSD1306_LEFT_RIGHT_REMAP_DISABLE);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set com pins hardware conf failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set contrast */
+    res = ssd1306_set_contrast(&gs_handle, 0xCF);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set contrast failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set pre charge period */
+    res = ssd1306_set_precharge_period(&gs_handle, 0x01, 0x0F);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set pre charge period failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set deselect level 0.77 */
+    res = ssd1306_set_deselect_level(&gs_handle, SSD1306_DESELECT_LEVEL_0P77);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set deselect level failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* entire display off */
+    res = ssd1306_set_entire_display(&gs_handle, SSD1306_ENTIRE_DISPLAY_OFF);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set entire display failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* set display mode */
+    res = ssd1306_set_display_mode(&gs_handle, SSD1306_DISPLAY_MODE_NORMAL);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set display mode failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* deactivate scroll */
+    res = ssd1306_deactivate_scroll(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set deactivate scroll failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* enable display */
+    res = ssd1306_set_display(&gs_handle, SSD1306_DISPLAY_ON);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set display failed.\n");
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* start flush test */
+    ssd1306_interface_debug_print("ssd1306: start flush test.\n");
+
+    /* byte mode */
+    if (a_ssd1306_flush_test_frame(SSD1306_FLUSH_MODE_BYTE, "byte") != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* page mode */
+    if (a_ssd1306_flush_test_frame(SSD1306_FLUSH_MODE_PAGE, "page") != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* page mode with the co bit */
+    if (interface == SSD1306_INTERFACE_IIC)
+    {
+        res = ssd1306_set_iic_transport(&gs_handle, SSD1306_IIC_TRANSPORT_CONTINUATION);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: set iic transport failed.\n");
+            (void)ssd1306_deinit(&gs_handle);
+
+            return 1;
+        }
+        if (a_ssd1306_flush_test_frame(SSD1306_FLUSH_MODE_PAGE, "page continuation") != 0)
+        {
+            (void)ssd1306_deinit(&gs_handle);
+
+            return 1;
+        }
+        res = ssd1306_set_iic_transport(&gs_handle, SSD1306_IIC_TRANSPORT_SEPARATE);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: set iic transport failed.\n");
+            (void)ssd1306_deinit(&gs_handle);
+
+            return 1;
+        }
+    }
+
+    /* spi clock probe */
+    if (interface != SSD1306_INTERFACE_IIC)
+    {
+        const uint32_t rate[] = {1000000, 2000000, 4000000, 8000000, 10000000};
+        uint32_t hz;
+
+        res = ssd1306_set_bus_speed(&gs_handle, rate[0]);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: set bus speed failed.\n");
+            (void)ssd1306_deinit(&gs_handle);
+
+            return 1;
+        }
+        res = ssd1306_probe_bus_speed(&gs_handle, rate, sizeof(rate) / sizeof(rate[0]), &hz);
+        if (res != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: probe bus speed failed.\n");
+            (void)ssd1306_deinit(&gs_handle);
+
+            return 1;
+        }
+        ssd1306_interface_debug_print("ssd1306: fastest stable spi clock is %d hz.\n", (int)hz);
+    }
+
+    /* spi clock list order */
+    if (interface != SSD1306_INTERFACE_IIC)
+    {
+        const uint32_t falling[] = {8000000, 4000000};
+        uint32_t hz;
+
+        res = ssd1306_probe_bus_speed(&gs_handle, falling, sizeof(falling) / sizeof(falling[0]), &hz);
+        if (res != 5)
+        {
+            ssd1306_interface_debug_print("ssd1306: falling rate list is not rejected.\n");
+            (void)ssd1306_deinit(&gs_handle);
+
+            return 1;
+        }
+    }
+
+    /* frame mode */
+    if (a_ssd1306_flush_test_frame(SSD1306_FLUSH_MODE_FRAME, "frame") != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* immediate points */
+    if (a_ssd1306_flush_test_points() != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+#if (SSD1306_STATS == 1)
+    /* stats */
+    if (a_ssd1306_flush_test_stats(interface) != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+#endif
+
+#if (SSD1306_TRACE_SIZE > 0)
+    /* trace */
+    if (a_ssd1306_flush_test_trace() != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+#endif
+
+#if (SSD1306_DOUBLE_BUFFER == 1)
+    /* double buffer */
+    if (a_ssd1306_flush_test_swap() != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+#endif
+
+#if (SSD1306_ASYNC_FLUSH == 1)
+    /* async mode, 3-wire spi has no async path */
+    if ((interface != SSD1306_INTERFACE_SPI_3WIRE) && (a_ssd1306_flush_test_async() != 0))
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+#endif
+
+    /* finish flush test */
+    ssd1306_interface_debug_print("ssd1306: finish flush test.\n");
+    (void)ssd1306_deinit(&gs_handle);
+
+    return 0;
+}
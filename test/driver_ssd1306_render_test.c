@@ -0,0 +1,469 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @file      driver_ssd1306_render_test.c
+ * @brief     driver ssd1306 render test source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/30  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/12/10  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ssd1306_render_test.h"
+
+static ssd1306_handle_t gs_handle;        /**< ssd1306 handle */
+
+/**
+ * @brief render test rect structure definition
+ */
+typedef struct ssd1306_render_test_rect_s
+{
+    const char *name;        /**< rect name */
+    uint8_t left;            /**< left coordinate x */
+    uint8_t top;             /**< top coordinate y */
+    uint8_t right;           /**< right coordinate x */
+    uint8_t bottom;          /**< bottom coordinate y */
+} ssd1306_render_test_rect_t;
+
+/**
+ * @brief render test rect table
+ */
+static const ssd1306_render_test_rect_t gs_rect[] =
+{
+    {"full screen", 0, 0, 127, 63},
+    {"page aligned", 16, 8, 111, 55},
+    {"unaligned", 3, 5, 100, 50},
+    {"horizontal line", 0, 10, 127, 10},
+    {"vertical line", 60, 0, 60, 63},
+    {"small box", 13, 13, 20, 20},
+};
+
+/**
+ * @brief     fill a rect point by point
+ * @param[in] *rect points to a rect structure
+ * @param[in] color is the fill color
+ * @return    status code
+ *            - 0 success
+ *            - 1 fill failed
+ * @note      it is the per pixel fill the page span fill replaces
+ */
+static uint8_t a_ssd1306_render_test_fill_point(const ssd1306_render_test_rect_t *rect, uint8_t color)
+{
+    uint8_t x;
+    uint8_t y;
+
+    for (x = rect->left; x <= rect->right; x++)
+    {
+        for (y = rect->top; y <= rect->bottom; y++)
+        {
+            if (ssd1306_gram_write_point(&gs_handle, x, y, color) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      hash the gram
+ * @param[out] *hash points to a hash buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ssd1306_render_test_hash(uint32_t *hash)
+{
+    uint8_t x;
+    uint8_t y;
+    uint8_t data;
+
+    *hash = 2166136261U;
+    for (x = 0; x < 128; x++)
+    {
+        for (y = 0; y < 64; y++)
+        {
+            if (ssd1306_gram_read_point(&gs_handle, x, y, &data) != 0)
+            {
+                return 1;
+            }
+            *hash = (*hash ^ data) * 16777619U;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     fill rect benchmark
+ * @param[in] times is the repeat times of each rect
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      both fills start from the same pattern and must leave the same gram
+ */
+static uint8_t a_ssd1306_render_test_fill_rect(uint16_t times)
+{
+    uint8_t i;
+    uint8_t x;
+    uint16_t j;
+    uint32_t t0;
+    uint32_t t_point;
+    uint32_t t_span;
+    uint32_t hash_point;
+    uint32_t hash_span;
+
+    for (i = 0; i < sizeof(gs_rect) / sizeof(gs_rect[0]); i++)
+    {
+        /* per pixel fill */
+        for (x = 0; x < 128; x++)
+        {
+            (void)ssd1306_gram_write_point(&gs_handle, x, (uint8_t)((x * 7) % 64), 1);
+        }
+        t0 = ssd1306_interface_timestamp_us();
+        for (j = 0; j < times; j++)
+        {
+            if (a_ssd1306_render_test_fill_point(&gs_rect[i], (uint8_t)(j & 0x01) ^ 0x01) != 0)
+            {
+                ssd1306_interface_debug_print("ssd1306: gram write point failed.\n");
+
+                return 1;
+            }
+        }
+        t_point = ssd1306_interface_timestamp_us() - t0;
+        if (a_ssd1306_render_test_hash(&hash_point) != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram read point failed.\n");
+
+            return 1;
+        }
+
+        /* page span fill */
+        if (ssd1306_gram_fill_rect(&gs_handle, 0, 0, 127, 63, 0) != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram fill rect failed.\n");
+
+            return 1;
+        }
+        for (x = 0; x < 128; x++)
+        {
+            (void)ssd1306_gram_write_point(&gs_handle, x, (uint8_t)((x * 7) % 64), 1);
+        }
+        t0 = ssd1306_interface_timestamp_us();
+        for (j = 0; j < times; j++)
+        {
+            if (ssd1306_gram_fill_rect(&gs_handle, gs_rect[i].left, gs_rect[i].top,
+                                       gs_rect[i].right, gs_rect[i].bottom, (uint8_t)(j & 0x01) ^ 0x01) != 0)
+            {
+                ssd1306_interface_debug_print("ssd1306: gram fill rect failed.\n");
+
+                return 1;
+            }
+        }
+        t_span = ssd1306_interface_timestamp_us() - t0;
+        if (a_ssd1306_render_test_hash(&hash_span) != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram read point failed.\n");
+
+            return 1;
+        }
+        if (hash_point != hash_span)
+        {
+            ssd1306_interface_debug_print("ssd1306: %s fill differs.\n", gs_rect[i].name);
+
+            return 1;
+        }
+        ssd1306_interface_debug_print("ssd1306: fill rect %s %d times took %dus point by point and %dus by page span.\n",
+                                      gs_rect[i].name, (int)times, (int)t_point, (int)t_span);
+
+        /* clear for the next rect */
+        if (ssd1306_gram_fill_rect(&gs_handle, 0, 0, 127, 63, 0) != 0)
+        {
+            ssd1306_interface_debug_print("ssd1306: gram fill rect failed.\n");
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     write string benchmark
+ * @param[in] times is the repeat times of each font
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_render_test_write_string(uint16_t times)
+{
+    const ssd1306_font_t font[3] = {SSD1306_FONT_12, SSD1306_FONT_16, SSD1306_FONT_24};
+    char str[] = "libdriver ssd1306";
+    uint8_t i;
+    uint16_t j;
+    uint32_t t0;
+    uint32_t t;
+
+    for (i = 0; i < 3; i++)
+    {
+        t0 = ssd1306_interface_timestamp_us();
+        for (j = 0; j < times; j++)
+        {
+            if (ssd1306_gram_write_string(&gs_handle, (uint8_t)(j % 7), (uint8_t)(j % 5), str,
+                                          (uint16_t)strlen(str), (uint8_t)(j & 0x01), font[i]) != 0)
+            {
+                ssd1306_interface_debug_print("ssd1306: gram write string failed.\n");
+
+                return 1;
+            }
+        }
+        t = ssd1306_interface_timestamp_us() - t0;
+        ssd1306_interface_debug_print("ssd1306: write string font %d %d chars took %dus.\n",
+                                      (int)font[i], (int)(times * strlen(str)), (int)t);
+    }
+
+    /* counter rows at the display test offsets */
+    t0 = ssd1306_interface_timestamp_us();
+    for (j = 0; j < times; j++)
+    {
+        for (i = 0; i < 5; i++)
+        {
+            str[i] = (char)('0' + (j / (i * 10 + 1)) % 10);
+        }
+        for (i = 0; i < 3; i++)
+        {
+            if (ssd1306_gram_write_string(&gs_handle, 0, (uint8_t)(15 + i * 16), str, 5, 1, SSD1306_FONT_16) != 0)
+            {
+                ssd1306_interface_debug_print("ssd1306: gram write string failed.\n");
+
+                return 1;
+            }
+        }
+    }
+    t = ssd1306_interface_timestamp_us() - t0;
+    ssd1306_interface_debug_print("ssd1306: write counter font 16 %d chars took %dus.\n", (int)(times * 15), (int)t);
+
+    return 0;
+}
+
+/**
+ * @brief     primitive benchmark
+ * @param[in] times is the repeat times of each primitive
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_ssd1306_render_test_primitive(uint16_t times)
+{
+    const ssd1306_point_t point[5] = {{64, -10}, {140, 20}, {100, 70}, {30, 70}, {-10, 20}};
+    const char *name[6] = {"line", "circle", "fill circle", "arc", "round rect", "polygon"};
+    uint8_t i;
+    uint8_t res;
+    uint16_t j;
+    uint32_t t0;
+    uint32_t t;
+
+    for (i = 0; i < 6; i++)
+    {
+        t0 = ssd1306_interface_timestamp_us();
+        for (j = 0; j < times; j++)
+        {
+            switch (i)
+            {
+                case 0 :
+                {
+                    res = ssd1306_gram_draw_line(&gs_handle, -20, (int16_t)(j % 64), 150, (int16_t)(63 - j % 64), (uint8_t)(j & 0x01));
+                    
+                    break;
+                }
+                case 1 :
+                {
+                    res = ssd1306_gram_draw_circle(&gs_handle, 64, 32, (uint8_t)(j % 40), (uint8_t)(j & 0x01));
+                    
+                    break;
+                }
+                case 2 :
+                {
+                    res = ssd1306_gram_fill_circle(&gs_handle, 64, 32, (uint8_t)(j % 40), (uint8_t)(j & 0x01));
+                    
+                    break;
+                }
+                case 3 :
+                {
+                    res = ssd1306_gram_draw_arc(&gs_handle, 64, 63, 60, 180, (uint16_t)(181 + j % 179), (uint8_t)(j & 0x01));
+                    
+                    break;
+                }
+                case 4 :
+                {
+                    res = ssd1306_gram_fill_round_rect(&gs_handle, 4, 4, 123, 59, (uint8_t)(j % 28), (uint8_t)(j & 0x01));
+                    
+                    break;
+                }
+                default :
+                {
+                    res = ssd1306_gram_fill_polygon(&gs_handle, point, 5, (uint8_t)(j & 0x01));
+                    
+                    break;
+                }
+            }
+            if (res != 0)
+            {
+                ssd1306_interface_debug_print("ssd1306: gram draw %s failed.\n", name[i]);
+
+                return 1;
+            }
+        }
+        t = ssd1306_interface_timestamp_us() - t0;
+        ssd1306_interface_debug_print("ssd1306: draw %s %d times took %dus.\n", name[i], (int)times, (int)t);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     render test
+ * @param[in] interface is the interface type
+ * @param[in] addr is the iic device address
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      only the gram is used, the panel is not configured
+ */
+uint8_t ssd1306_render_test(ssd1306_interface_t interface, ssd1306_address_t addr)
+{
+    uint8_t res;
+    ssd1306_info_t info;
+
+    /* link functions */
+    DRIVER_SSD1306_LINK_INIT(&gs_handle, ssd1306_handle_t);
+    DRIVER_SSD1306_LINK_IIC_INIT(&gs_handle, ssd1306_interface_iic_init);
+    DRIVER_SSD1306_LINK_IIC_DEINIT(&gs_handle, ssd1306_interface_iic_deinit);
+    DRIVER_SSD1306_LINK_IIC_WRITE(&gs_handle, ssd1306_interface_iic_write);
+    DRIVER_SSD1306_LINK_SPI_INIT(&gs_handle, ssd1306_interface_spi_init);
+    DRIVER_SSD1306_LINK_SPI_DEINIT(&gs_handle, ssd1306_interface_spi_deinit);
+    DRIVER_SSD1306_LINK_SPI_WRITE_COMMAND(&gs_handle, ssd1306_interface_spi_write_cmd);
+    DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_INIT(&gs_handle, ssd1306_interface_spi_cmd_data_gpio_init);
+    DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_DEINIT(&gs_handle, ssd1306_interface_spi_cmd_data_gpio_deinit);
+    DRIVER_SSD1306_LINK_SPI_COMMAND_DATA_GPIO_WRITE(&gs_handle, ssd1306_interface_spi_cmd_data_gpio_write);
+    DRIVER_SSD1306_LINK_RESET_GPIO_INIT(&gs_handle, ssd1306_interface_reset_gpio_init);
+    DRIVER_SSD1306_LINK_RESET_GPIO_DEINIT(&gs_handle, ssd1306_interface_reset_gpio_deinit);
+    DRIVER_SSD1306_LINK_RESET_GPIO_WRITE(&gs_handle, ssd1306_interface_reset_gpio_write);
+    DRIVER_SSD1306_LINK_DELAY_MS(&gs_handle, ssd1306_interface_delay_ms);
+    DRIVER_SSD1306_LINK_DEBUG_PRINT(&gs_handle, ssd1306_interface_debug_print);
+#if ((SSD1306_STATS == 1) || (SSD1306_TRACE_SIZE > 0))
+    DRIVER_SSD1306_LINK_TIMESTAMP_US(&gs_handle, ssd1306_interface_timestamp_us);
+#endif
+
+    /* ssd1306 info */
+    res = ssd1306_info(&info);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: get info failed.\n");
+
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        ssd1306_interface_debug_print("ssd1306: chip is %s.\n", info.chip_name);
+        ssd1306_interface_debug_print("ssd1306: manufacturer is %s.\n", info.manufacturer_name);
+        ssd1306_interface_debug_print("ssd1306: interface is %s.\n", info.interface);
+        ssd1306_interface_debug_print("ssd1306: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        ssd1306_interface_debug_print("ssd1306: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ssd1306_interface_debug_print("ssd1306: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ssd1306_interface_debug_print("ssd1306: max current is %0.2fmA.\n", info.max_current_ma);
+        ssd1306_interface_debug_print("ssd1306: max temperature is %0.1fC.\n", info.temperature_max);
+        ssd1306_interface_debug_print("ssd1306: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+
+    /* set interface */
+    res = ssd1306_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set interface failed.\n");
+
+        return 1;
+    }
+
+    /* set addr pin */
+    res = ssd1306_set_addr_pin(&gs_handle, addr);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: set addr failed.\n");
+
+        return 1;
+    }
+
+    /* ssd1306 init */
+    res = ssd1306_init(&gs_handle);
+    if (res != 0)
+    {
+        ssd1306_interface_debug_print("ssd1306: init failed.\n");
+
+        return 1;
+    }
+
+    /* start render test */
+    ssd1306_interface_debug_print("ssd1306: start render test.\n");
+
+    /* fill rect */
+    if (a_ssd1306_render_test_fill_rect(100) != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* write string */
+    if (a_ssd1306_render_test_write_string(100) != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* primitive */
+    if (a_ssd1306_render_test_primitive(100) != 0)
+    {
+        (void)ssd1306_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* finish render test */
+    ssd1306_interface_debug_print("ssd1306: finish render test.\n");
+    (void)ssd1306_deinit(&gs_handle);
+
+    return 0;
+}